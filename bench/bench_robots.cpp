@@ -0,0 +1,104 @@
+// bench_robots.cpp - robots.txt matcher microbenchmark
+// LLM Documentation Scraper - C++ Implementation
+//
+// Compares RobotsHandler::is_allowed (compiled trie) against the previous matcher, which
+// prefix-compared the path with every allow and disallow rule.
+//
+// Usage: bench_robots [rules] [paths]
+
+#include "fetch/robots.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The matcher RobotsHandler used before rules were compiled (prefix only, no '*' or '$')
+struct LegacyMatcher {
+    std::vector<std::string> allow;
+    std::vector<std::string> disallow;
+
+    static bool matches_rule(const std::string& path, const std::string& rule_path) {
+        if (rule_path.empty()) return false;
+        if (rule_path == "/") return true;
+        return path.rfind(rule_path, 0) == 0;
+    }
+
+    bool is_allowed(const std::string& path) const {
+        int best_allow = -1;
+        int best_disallow = -1;
+        for (const auto& a : allow)
+            if (matches_rule(path, a)) best_allow = std::max(best_allow, static_cast<int>(a.size()));
+        for (const auto& d : disallow)
+            if (matches_rule(path, d)) best_disallow = std::max(best_disallow, static_cast<int>(d.size()));
+        if (best_allow == -1 && best_disallow == -1) return true;
+        return best_allow >= best_disallow;
+    }
+};
+
+std::string random_segment(std::mt19937& rng) {
+    static const char* words[] = {"docs", "api", "v1", "v2", "guide", "reference", "blog", "search",
+                                  "private", "tmp", "user", "account", "print", "static", "assets"};
+    return words[rng() % (sizeof(words) / sizeof(words[0]))];
+}
+
+std::string random_path(std::mt19937& rng, int segments) {
+    std::string p;
+    for (int i = 0; i < segments; ++i) p += "/" + random_segment(rng) + std::to_string(rng() % 50);
+    return p;
+}
+
+template <typename F>
+double time_ns_per_call(const std::vector<std::string>& paths, int rounds, F&& f, size_t& allowed) {
+    auto start = std::chrono::steady_clock::now();
+    allowed = 0;
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& p : paths) allowed += f(p) ? 1 : 0;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(ns) / (static_cast<double>(paths.size()) * rounds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rule_count = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int path_count = argc > 2 ? std::atoi(argv[2]) : 10000;
+
+    // Prefix-only rules so both matchers agree and the comparison is like for like
+    std::mt19937 rng(42);
+    std::string robots = "User-agent: *\n";
+    LegacyMatcher legacy;
+    for (int i = 0; i < rule_count; ++i) {
+        std::string rule = random_path(rng, 1 + static_cast<int>(rng() % 3));
+        if (i % 4 == 0) {
+            robots += "Allow: " + rule + "\n";
+            legacy.allow.push_back(rule);
+        } else {
+            robots += "Disallow: " + rule + "\n";
+            legacy.disallow.push_back(rule);
+        }
+    }
+    docscraper::fetch::RobotsHandler handler;
+    handler.parse(robots);
+
+    std::vector<std::string> paths;
+    paths.reserve(path_count);
+    for (int i = 0; i < path_count; ++i) paths.push_back(random_path(rng, 2 + static_cast<int>(rng() % 4)));
+
+    int rounds = 5;
+    size_t legacy_allowed = 0, compiled_allowed = 0;
+    double legacy_ns = time_ns_per_call(paths, rounds, [&](const std::string& p) { return legacy.is_allowed(p); }, legacy_allowed);
+    double compiled_ns = time_ns_per_call(paths, rounds, [&](const std::string& p) { return handler.is_allowed(p); }, compiled_allowed);
+
+    std::printf("rules=%d paths=%d\n", rule_count, path_count);
+    std::printf("legacy   %10.1f ns/path  (allowed %zu)\n", legacy_ns, legacy_allowed);
+    std::printf("compiled %10.1f ns/path  (allowed %zu)\n", compiled_ns, compiled_allowed);
+    if (legacy_allowed != compiled_allowed) {
+        std::printf("MISMATCH between matchers\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+// host_scheduler.hpp - Ready-Host Scheduler on top of RateLimiter
+// LLM Documentation Scraper - C++ Implementation
+
+#pragma once
+
+#include "fetch/rate_limiter.hpp"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace docscraper::fetch {
+
+// Min-heap of hosts keyed by the time RateLimiter next allows them, so a single thread can
+// pace any number of hosts: push() a host when it has queued work, pop_ready() hands back
+// hosts whose slot has come (the caller then reserve()s it), and next_ready() tells an
+// event loop how long it may sleep. A host is in the heap at most once. Heap times are
+// re-checked on pop, so a later Retry-After or delay change is still respected. Not
+// thread-safe; meant to be owned by one scheduler thread.
+class HostScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit HostScheduler(RateLimiter& limiter);
+
+    // Schedule host at its earliest allowed time; no-op if already scheduled
+    void push(const std::string& host);
+
+    // A host whose slot is due at now, or nullopt. The host leaves the heap.
+    std::optional<std::string> pop_ready(Clock::time_point now);
+
+    // Time of the earliest scheduled host, or nullopt when empty
+    std::optional<Clock::time_point> next_ready() const;
+
+    size_t size() const { return heap_.size(); }
+    bool empty() const { return heap_.empty(); }
+
+private:
+    struct Item {
+        Clock::time_point at;
+        uint64_t seq;        // FIFO among hosts ready at the same time
+        std::string host;
+        bool operator>(const Item& o) const { return at != o.at ? at > o.at : seq > o.seq; }
+    };
+
+    RateLimiter& limiter_;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap_;
+    std::unordered_set<std::string> scheduled_;
+    uint64_t seq_ = 0;
+};
+
+} // namespace docscraper::fetch
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <mutex>
 #include <random>
@@ -11,29 +12,79 @@
 
 namespace docscraper::fetch {
 
+// Adaptive (AIMD) pacing: a host's request rate grows additively while responses are healthy
+// and latency stays near its baseline, and is cut multiplicatively on 429/503, other 5xx,
+// network errors or a latency spike. Delays set with set_host_delay (e.g. robots Crawl-delay)
+// remain a floor.
+struct AdaptiveRateOptions {
+    std::chrono::milliseconds min_delay{100};     // fastest pace (10 req/s)
+    std::chrono::milliseconds max_delay{60000};   // slowest pace
+    double increase_rps = 0.2;       // added to the rate per healthy response
+    double error_backoff = 0.5;      // rate multiplier on 429/503/5xx/network error
+    double latency_backoff = 0.8;    // rate multiplier on a latency spike
+    double latency_spike = 2.0;      // spike = latency above this multiple of the baseline
+};
+
 class RateLimiter {
 public:
     explicit RateLimiter(std::chrono::milliseconds default_delay);
 
-    // Wait until allowed to make request to host
+    // Switch to adaptive pacing; default_delay becomes each host's starting delay
+    void enable_adaptive(const AdaptiveRateOptions& options);
+    bool adaptive() const;
+
+    // Feed back one response: status 0 = network error. retry_after (> 0) blocks the host
+    // until it has passed, in both fixed and adaptive mode.
+    void record_response(const std::string& host, int status, std::chrono::milliseconds latency,
+                         std::chrono::seconds retry_after = std::chrono::seconds(0));
+
+    // Earliest time a Retry-After allows the next request to host (epoch if not blocked)
+    std::chrono::steady_clock::time_point blocked_until(const std::string& host) const;
+
+    // Claim the next request slot for host without blocking and return when it starts
+    // (now or later). Concurrent callers for one host get successive slots.
+    std::chrono::steady_clock::time_point reserve(const std::string& host);
+
+    // Earliest time a request to host would be allowed, without claiming it. Jitter for the
+    // next gap is drawn when the previous slot is reserved, so this matches reserve().
+    std::chrono::steady_clock::time_point earliest(const std::string& host) const;
+
+    // Wait until allowed to make request to host: reserve() then sleep until the slot.
     void wait_for_host(const std::string& host);
 
     // Set per-host delay override
     void set_host_delay(const std::string& host, std::chrono::milliseconds delay);
 
-    // Get current delay for host
+    // Get current delay for host (the adaptive delay in adaptive mode)
     std::chrono::milliseconds get_host_delay(const std::string& host) const;
 
     // Reset host state (e.g., when resuming)
     void reset_host(const std::string& host);
 
 private:
+    struct AdaptiveState {
+        double rate = 0.0;                 // requests per second
+        double latency_baseline_ms = 0.0;  // EWMA of healthy response latency
+        int samples = 0;
+    };
+
     std::chrono::milliseconds default_delay_;
     mutable std::mutex mutex_;
     std::map<std::string, std::chrono::milliseconds> host_delays_;
     std::map<std::string, std::chrono::steady_clock::time_point> last_request_;
+    std::map<std::string, std::chrono::steady_clock::time_point> blocked_until_;
+    bool adaptive_ = false;
+    AdaptiveRateOptions adaptive_options_;
+    std::map<std::string, AdaptiveState> adaptive_state_;
+    std::map<std::string, double> next_jitter_;  // +/-10% applied to the next gap per host
+    std::mt19937 rng_{std::random_device{}()};  // jitter; guarded by mutex_
 
-    std::chrono::milliseconds add_jitter(std::chrono::milliseconds delay);
+    std::chrono::milliseconds delay_locked(const std::string& host) const;
+    std::chrono::steady_clock::time_point earliest_locked(const std::string& host) const;
 };
 
+// Retry-After as delta-seconds or an HTTP-date (relative to now_unix), capped at 10 minutes;
+// 0 if absent or invalid.
+std::chrono::seconds parse_retry_after(const std::string& value, int64_t now_unix);
+
 } // namespace docscraper::fetch
@@ -3,18 +3,56 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 namespace docscraper::fetch {
 
+// Allow/disallow patterns of one group compiled into a trie. '*' matches any run of
+// characters and a trailing '$' anchors the pattern to the end of the path (RFC 9309).
+// match() walks the path once, tracking the set of live trie states, and reports the
+// longest matching allow and disallow pattern.
+class RobotsMatcher {
+public:
+    struct Result {
+        int allow = -1;     // length of the longest matching allow pattern, -1 = none
+        int disallow = -1;  // same for disallow
+    };
+
+    void add(const std::string& pattern, bool allow);
+    Result match(const std::string& path) const;
+    bool empty() const { return nodes_.size() <= 1; }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Node {
+        uint32_t star = kNone;    // child reached by '*'
+        bool self_loop = false;   // this node is a '*': it consumes any byte
+        int allow = -1;           // pattern ends here, matches any continuation
+        int disallow = -1;
+        int allow_end = -1;       // pattern ends here with '$'
+        int disallow_end = -1;
+    };
+
+    std::vector<Node> nodes_{Node{}};                // node 0 is the root
+    std::unordered_map<uint64_t, uint32_t> edges_;   // (node << 8 | byte) -> child
+    bool has_star_ = false;                          // false: a plain trie walk suffices
+
+    uint32_t child(uint32_t node, unsigned char c) const;
+    uint32_t add_child(uint32_t node, unsigned char c);
+};
+
 struct RobotsRule {
     std::string user_agent;
     std::vector<std::string> disallow;
     std::vector<std::string> allow;
     std::vector<std::string> sitemaps;
     int crawl_delay_seconds = -1;
+    RobotsMatcher matcher;  // built from allow/disallow at the end of parse()
 };
 
 class RobotsHandler {
@@ -30,11 +68,13 @@ public:
     // Get sitemap URLs discovered in robots.txt
     std::vector<std::string> get_sitemaps() const;
 
+    // Crawl-delay for user agent (falls back to "*"); -1 if not set
+    int crawl_delay_seconds(const std::string& user_agent = "*") const;
+
 private:
     std::map<std::string, RobotsRule> rules_;
 
     const RobotsRule* get_rule_for_agent(const std::string& user_agent) const;
-    static bool matches_rule(const std::string& path, const std::string& rule_path);
 };
 
 } // namespace docscraper::fetch
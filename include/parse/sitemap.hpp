@@ -0,0 +1,58 @@
+// sitemap.hpp - Streaming Sitemap Parser
+// LLM Documentation Scraper - C++ Implementation
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace docscraper::parse {
+
+// One <url> of a urlset, or one <sitemap> of a sitemap index
+struct SitemapEntry {
+    std::string loc;
+    std::string lastmod;      // raw W3C datetime, empty if absent
+    bool is_sitemap = false;  // true = nested sitemap (from a sitemapindex)
+};
+
+// Push parser for sitemap XML (sitemaps.org 0.9). Bytes are fed as they arrive; only the
+// current tag and field text are buffered, so memory stays constant for any file size.
+// Handles namespace prefixes, comments, CDATA and the predefined/numeric entities.
+class SitemapParser {
+public:
+    // Return false to stop parsing
+    using Callback = std::function<bool(const SitemapEntry&)>;
+
+    explicit SitemapParser(Callback on_entry);
+
+    // Feed the next chunk of (decoded) XML. Returns false once the callback stopped parsing.
+    bool feed(const char* data, size_t len);
+
+    size_t entries() const { return entries_; }
+
+private:
+    enum class State { Text, Tag };
+
+    Callback on_entry_;
+    State state_ = State::Text;
+    std::string tag_;          // bytes between '<' and '>'
+    std::string text_;         // text of the current <loc>/<lastmod>
+    std::string field_;        // "loc" or "lastmod" while capturing
+    SitemapEntry entry_;
+    bool in_entry_ = false;
+    bool capturing_ = false;
+    bool overflow_ = false;    // field text exceeded the size cap; the entry is dropped
+    bool stopped_ = false;
+    size_t entries_ = 0;
+
+    bool tag_complete() const;
+    void handle_tag();
+    void append_text(const char* data, size_t len);
+};
+
+// Parse a W3C datetime (YYYY, YYYY-MM, YYYY-MM-DD, or with Thh:mm[:ss[.s]]TZD) to Unix
+// seconds. Returns 0 if the value cannot be parsed.
+int64_t parse_w3c_datetime(const std::string& value);
+
+} // namespace docscraper::parse
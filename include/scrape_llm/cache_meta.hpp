@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace scrapellm {
+
+// HTTP validators and freshness info for one cached page.
+struct CacheEntryMeta {
+    std::string etag;
+    std::string last_modified;
+    std::string cache_control;
+    int64_t fetched_at = 0;  // unix seconds of the last 200 or 304
+};
+
+// Per-URL cache metadata persisted as cache/meta.json (keyed by normalized URL). Thread-safe.
+class CacheMetaStore {
+public:
+    // Loads path if it exists; a missing or unreadable file starts empty.
+    explicit CacheMetaStore(std::string path);
+
+    std::optional<CacheEntryMeta> get(const std::string& normalized_url) const;
+    void put(const std::string& normalized_url, CacheEntryMeta meta);
+    void erase(const std::string& normalized_url);
+
+    // Drop every entry whose URL keep rejects (e.g. pages evicted from the page cache).
+    void retain(const std::function<bool(const std::string&)>& keep);
+
+    // Write to disk (temp file + rename) if anything changed since the last save.
+    bool save();
+
+private:
+    std::string path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, CacheEntryMeta> entries_;
+    bool dirty_ = false;
+};
+
+// Current time as unix seconds.
+int64_t unix_now();
+
+// True if the cached copy may be served without contacting the server: age is below
+// Cache-Control max-age (or default_max_age_s when none is given) and no-cache is not set.
+bool cache_entry_fresh(const CacheEntryMeta& meta, int64_t now, int64_t default_max_age_s);
+
+// True if Cache-Control forbids storing the response.
+bool cache_control_no_store(const std::string& cache_control);
+
+} // namespace scrapellm
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "scrape_llm/cli_config.hpp"
+#include "scrape_llm/crawl_frontier.hpp"
+#include "scrape_llm/relevance_router.hpp"
+#include "scrape_llm/types.hpp"
+#include "utils/url_seen_set.hpp"
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace scrapellm {
+
+// Resumable run state under out_dir/checkpoint.
+//
+// The crawl is saved as a generation: frontier-<gen>.jsonl (pending and in-flight URLs, with
+// spilled frontier segments linked in as frontier-<gen>-<n>.seg) and seen-<gen>.bin (UrlSeenSet
+// fingerprints) are written first, then state.json (crawled pages, report counters, generation)
+// replaces the previous one by rename, which commits it. A crash mid-save leaves the previous
+// generation intact. Page HTML is not copied; it stays in the page cache, which is flushed with
+// every checkpoint.
+//
+// LLM results are memoized per URL as they complete, in append-only relevance.jsonl and
+// parsed.jsonl; a torn last line is ignored on load.
+//
+// A checkpoint only resumes a run with the same url and schema. Not thread-safe.
+class Checkpoint {
+public:
+    struct CrawledPage {
+        std::string url;
+        std::string normalized_url;  // page cache key
+        std::string final_url;
+        int depth = 0;
+        uint64_t simhash = 0;
+    };
+
+    struct CrawlState {
+        bool done = false;  // crawl finished; only the LLM stages remain
+        std::vector<CrawledPage> crawled;
+        RunReport report;   // crawl counters so far
+    };
+
+    explicit Checkpoint(const RunConfig& config);
+
+    const std::string& dir() const { return dir_; }
+
+    // Delete any previous checkpoint (a fresh run).
+    void reset();
+
+    // Save the crawl as a new generation. False (previous generation kept) on a write error.
+    bool save_crawl(const CrawlState& state, const CrawlFrontier& frontier,
+                    const std::vector<CrawlFrontier::Entry>& in_flight, const docscraper::utils::UrlSeenSet& seen);
+
+    // Load the last committed generation into state, frontier and seen, and the LLM memos.
+    // False if there is none, it is truncated, or it belongs to a different url or schema.
+    // frontier (expected empty) is filled as the file is read, so it spills as usual, and is
+    // cleared again on false.
+    bool load(CrawlState& state, CrawlFrontier& frontier, docscraper::utils::UrlSeenSet& seen);
+
+    // Memoized LLM results; nullptr if the page has not been decided / parsed yet.
+    const RelevanceDecision* relevance(const std::string& url) const;
+    void record_relevance(const std::string& url, const RelevanceDecision& decision);
+    const ParsedPage* parsed(const std::string& url) const;
+    void record_parsed(const std::string& url, const ParsedPage& page);
+
+private:
+    std::string dir_;
+    std::string url_;
+    std::string schema_;
+    uint64_t generation_ = 0;
+    std::map<std::string, RelevanceDecision> relevance_;
+    std::map<std::string, ParsedPage> parsed_;
+    std::ofstream relevance_log_;
+    std::ofstream parsed_log_;
+
+    std::string path(const std::string& name) const { return dir_ + "/" + name; }
+    std::string frontier_path(uint64_t gen) const;
+    std::string segment_name(uint64_t gen, size_t index) const;
+    std::string seen_path(uint64_t gen) const;
+    void remove_generations_except(uint64_t gen) const;
+    void load_memos();
+    void append(std::ofstream& log, const std::string& name, const json& line);
+};
+
+} // namespace scrapellm
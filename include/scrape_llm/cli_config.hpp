@@ -3,6 +3,7 @@
 #include <string>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 
 namespace scrapellm {
 
@@ -14,13 +15,38 @@ struct RunConfig {
     int max_pages = 30;
     int max_depth = 2;
     int keep_pages = 10;
-    double rate_limit = 1.0;       // requests per second
+    int near_dup_distance = 3;     // SimHash bits within which pages count as duplicates (-1 = off)
+    bool use_canonical = true;     // pages naming the same <link rel="canonical"> are crawled once
+    std::string crawl_order = "best-first";  // best-first | bfs
+    bool link_model = false;       // learn from relevance decisions which links lead to kept pages
+    double skip_predicted = 0.0;   // skip links the link model predicts SKIP with this confidence, in (0.5, 1] (0 = off)
+    bool link_graph = true;        // record links between pages: in-degree boosts the frontier, PageRank orders kept pages
+    bool export_graph = false;     // write the link graph to out/graph
+    int max_pagination = 100;      // list mode: pages followed along one pagination chain past max_depth (0 = off)
+    int max_per_template = 0;      // pages fetched per URL template (0 = no cap)
+    int template_probe = 0;        // pages of a template fetched before an off-topic one is sampled (0 = never)
+    int64_t frontier_memory = 200000;  // frontier URLs held in memory; the rest spill to out/frontier
+    double rate_limit = 1.0;       // requests per second (starting rate with adaptive_rate)
+    bool adaptive_rate = false;    // AIMD per-host pacing from latency and 429/503
+    double max_rate = 10.0;        // per-host ceiling for adaptive_rate, requests per second
+    int crawl_workers = 1;         // parallel fetch threads
+    int connections_per_host = 2;  // keep-alive connections pooled per origin
+    std::string fetch_backend = "httplib";  // httplib | curl-multi
+    int max_in_flight = 64;        // concurrent transfers for curl-multi
+    int64_t cache_max_age_s = 86400;  // freshness of cached pages without Cache-Control max-age
+    int64_t cache_max_mb = 1024;   // page cache budget; least recently used pages are evicted (0 = unbounded)
+    int64_t max_page_bytes = 10 << 20;  // larger pages are abandoned mid-download
+    bool seed_from_sitemaps = false;  // seed the frontier from robots.txt / sitemap.xml sitemaps
     bool respect_robots = true;
+    int64_t robots_ttl_s = 86400;  // how long a cached robots.txt is reused (also across runs)
     bool allow_private_network = false;
     std::string model = "gpt-4.1-mini";
     std::string base_url;          // empty = use default Gemini/OpenAI
     bool emit_csv = false;
     bool dry_run = false;
+    bool incremental = false;      // reuse LLM results for pages unchanged since the last run
+    bool resume = false;           // continue from out/checkpoint when it matches url and schema
+    int64_t checkpoint_interval_s = 60;  // seconds between crawl checkpoints (0 = only when the crawl ends)
 
     std::chrono::milliseconds rate_limit_delay_ms() const;
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace httplib { class Client; }
+
+namespace scrapellm {
+
+// Per-origin pool of keep-alive httplib clients. A Lease gives one thread exclusive use of a
+// client; when the lease ends the client (and its open TCP/TLS connection) goes back to the pool
+// so the next request to that origin skips the handshakes.
+class ConnectionPool {
+public:
+    struct Options {
+        int max_per_host = 2;                        // open clients per origin; acquire blocks beyond this
+        std::chrono::seconds idle_timeout{30};       // idle clients older than this are closed
+    };
+
+    class Lease {
+    public:
+        Lease(ConnectionPool* pool, std::string origin, std::unique_ptr<httplib::Client> client);
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease();
+
+        httplib::Client& client() { return *client_; }
+        httplib::Client* operator->() { return client_.get(); }
+
+        // Drop the client instead of returning it (e.g. after a connection error).
+        void discard() { discard_ = true; }
+
+    private:
+        ConnectionPool* pool_;
+        std::string origin_;
+        std::unique_ptr<httplib::Client> client_;
+        bool discard_ = false;
+    };
+
+    explicit ConnectionPool(Options options);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // origin is scheme://host[:port]. Reuses a warm idle client when available.
+    Lease acquire(const std::string& origin);
+
+    // Close idle clients whose last use is older than idle_timeout.
+    void evict_idle();
+
+private:
+    struct IdleClient {
+        std::unique_ptr<httplib::Client> client;
+        std::chrono::steady_clock::time_point last_used;
+    };
+    struct HostSlot {
+        std::vector<IdleClient> idle;  // most recently used at the back
+        int open = 0;                  // leased + idle
+    };
+
+    Options options_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::string, HostSlot> hosts_;
+
+    void release(const std::string& origin, std::unique_ptr<httplib::Client> client, bool discard);
+    void evict_idle_locked(std::chrono::steady_clock::time_point now);
+};
+
+} // namespace scrapellm
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "scrape_llm/link_scorer.hpp"
 #include "scrape_llm/types.hpp"
 #include <string>
 #include <vector>
@@ -20,4 +21,16 @@ std::vector<std::string> extract_links_absolute(
     const std::string& base_url
 );
 
+// Like extract_links_absolute, with each link's anchor text, rel and the nearest heading above
+// it (for LinkScorer). Text is whitespace-collapsed and cut to 200 chars. <link rel="next">
+// elements are included as links without anchor text.
+std::vector<LinkContext> extract_links_with_context(
+    const docscraper::parse::HTMLDocument& doc,
+    const std::string& base_url
+);
+
+// URL of the page's <link rel="canonical" href>, resolved against base_url and normalized;
+// empty if there is none. A string scan of the document head, so it can run before parsing.
+std::string canonical_link(const std::string& html, const std::string& base_url);
+
 } // namespace scrapellm
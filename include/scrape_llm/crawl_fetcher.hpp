@@ -2,13 +2,29 @@
 
 #include "scrape_llm/cli_config.hpp"
 #include "scrape_llm/ssrf_guard.hpp"
+#include "scrape_llm/connection_pool.hpp"
+#include "scrape_llm/dns_cache.hpp"
+#include "scrape_llm/cache_meta.hpp"
+#include "scrape_llm/page_store.hpp"
+#include "scrape_llm/redirect_map.hpp"
+#include "scrape_llm/robots_cache.hpp"
+#include "scrape_llm/stream_decoder.hpp"
+#include "scrape_llm/types.hpp"
 #include "fetch/rate_limiter.hpp"
 #include "fetch/robots.hpp"
+#include "parse/normalizer.hpp"
+#include "parse/sitemap.hpp"
+#include "utils/url_seen_set.hpp"
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include <map>
+#include <chrono>
 #include <functional>
+#include <future>
+#include <mutex>
+#include <memory>
 #include <optional>
+#include <unordered_map>
 
 namespace scrapellm {
 
@@ -16,41 +32,175 @@ struct CrawlResult {
     std::string url;
     std::string normalized_url;
     int depth = 0;
-    std::string html;
-    std::string final_url;
+    std::string html;           // released by the Crawler once the page is parsed into content
+    std::string final_url;      // normalized URL the page was served from, after redirects
     bool success = false;
     std::string error;
+    int64_t wire_bytes = 0;     // body bytes as transferred (compressed when encoded)
+    int64_t decoded_bytes = 0;  // body bytes after Content-Encoding decoding
+    uint64_t simhash = 0;       // SimHash of the main text, set by the Crawler (0 = too short)
+    bool on_topic = false;      // main text matches the schema's keywords, set by the Crawler
+    int pagination = 0;         // pagination links followed in a row to reach the page, set by the Crawler
+    ExtractedContent content;   // text, headings and tables of the page, set by the Crawler
+};
+
+// Request target for one URL once the pre-network checks have passed (see begin_fetch).
+struct FetchTarget {
+    std::string normalized_url;
+    std::string host;
+    std::string origin;  // scheme://host[:port]
+    std::string path;    // path plus "?query"
+    int port = 0;        // effective port (80/443 when the URL has none)
+    std::vector<std::string> addresses;  // resolved and checked IPs, preferred first; backends connect
+                                         // to these instead of resolving again
+    // Validators of a stale cached copy; when set, the request is conditional.
+    std::string if_none_match;
+    std::string if_modified_since;
+
+    bool conditional() const { return !if_none_match.empty() || !if_modified_since.empty(); }
+};
+
+// Response fields a fetch backend hands back to finish_fetch.
+struct FetchResponse {
+    bool network_ok = false;
+    int status = 0;
+    std::string content_type;
+    std::string etag;
+    std::string last_modified;
+    std::string cache_control;
+    std::string content_encoding;
+    std::string retry_after;
+    std::string location;  // Location header of a redirect
+    std::chrono::milliseconds latency{0};  // time to response headers
+    std::string body;   // decoded
+    std::string error;  // set when the transfer was stopped early (not HTML, too large)
+    int64_t wire_bytes = 0;
+    std::unique_ptr<StreamDecoder> decoder;  // set by accept_headers for encoded bodies
 };
 
 // Fetches pages with rate limiting, robots, SSRF guard, and optional disk cache.
+// Safe to share between crawl workers: seen set, robots and cache writes are synchronized.
 class CrawlFetcher {
 public:
     explicit CrawlFetcher(const RunConfig& config);
+    ~CrawlFetcher();
 
-    // Fetch robots.txt for the host of base_url; parses and stores. Returns body (or empty if failed).
+    // Load robots.txt for the origin of base_url (from the robots cache or the network).
+    // Returns the body, or empty if there is none.
     std::string fetch_robots(const std::string& base_url);
 
+    // Sitemap URLs listed in the start URL's robots.txt.
+    std::vector<std::string> robots_sitemaps();
+
+    // Stream one sitemap or sitemap index (plain or gzip) through SitemapParser, calling on_entry
+    // per entry. Rate limited and SSRF-checked like page fetches. Returns false (with error) if
+    // the fetch failed.
+    bool fetch_sitemap(const std::string& url, const docscraper::parse::SitemapParser::Callback& on_entry,
+                       std::string& error);
+
     // Fetch one URL. Respects rate limit and robots. Returns nullopt if blocked or error.
-    std::optional<CrawlResult> fetch(const std::string& url, int depth);
+    // lastmod (Unix seconds, 0 = unknown) is a sitemap hint; see begin_fetch.
+    std::optional<CrawlResult> fetch(const std::string& url, int depth, int64_t lastmod = 0);
+
+    // Pre-network steps shared by all backends: SSRF, URL parse, cache lookup, DNS. Returns a
+    // finished result when no request is needed; otherwise fills target (including the pinned
+    // address) and returns nullopt. A cached copy fetched after a known lastmod is treated as fresh.
+    std::optional<CrawlResult> begin_fetch(const std::string& url, int depth, FetchTarget& target,
+                                           int64_t lastmod = 0);
+
+    // Called by a backend once status and headers are known (content_length -1 if unknown).
+    // Returns false when the body should not be downloaded; response.error then says why.
+    bool accept_headers(FetchResponse& response, int64_t content_length) const;
+
+    // Append a body chunk as received, decoding it if needed (dropped for non-200); false with
+    // response.error set once the decoded body exceeds --max-page-bytes or does not decode.
+    bool append_body(FetchResponse& response, const char* data, size_t len) const;
+
+    // Turn a backend's response into a CrawlResult; successful HTML is written to the cache.
+    // A 304 to a conditional request is served from the cache. Status, latency and Retry-After
+    // are fed back to the RateLimiter.
+    CrawlResult finish_fetch(const std::string& url, int depth, const FetchTarget& target, FetchResponse response);
+
+    // True for a 304 to a conditional request whose cached copy has been evicted since
+    // begin_fetch. The response is fed to the RateLimiter and the validators are cleared, so the
+    // caller requests target once more, unconditionally, and passes that response on instead.
+    bool retry_unconditional(FetchTarget& target, const FetchResponse& response);
+
+    // Backends do not follow redirects themselves; they pass each 3xx response with a Location
+    // here. The hop is recorded (permanent ones in redirects()) and its target goes through
+    // begin_fetch and robots like any URL, so every hop is SSRF-checked and pinned. Returns
+    // nullopt with target replaced when the caller should request target next; otherwise the
+    // finished result for url (served from the cache, blocked, or too many redirects).
+    // hops counts the redirects followed so far for url.
+    std::optional<CrawlResult> follow_redirect(const std::string& url, int depth, int hops,
+                                               FetchTarget& target, const FetchResponse& response);
+
+    // The checks of follow_redirect that never block, for the event loop: on nullopt, next_url is
+    // the normalized hop target, still to be checked against robots.txt (redirect_blocked if it is
+    // disallowed) and passed to begin_fetch.
+    std::optional<CrawlResult> redirect_target(const std::string& url, int depth, int hops,
+                                               const FetchTarget& target, const FetchResponse& response,
+                                               std::string& next_url);
+    static CrawlResult redirect_blocked(const std::string& url, int depth, const FetchTarget& target);
+
+    // True for a response follow_redirect should handle.
+    static bool is_redirect(const FetchResponse& response) {
+        return response.network_ok && is_followed_redirect(response.status) && !response.location.empty();
+    }
+
+    // Check whether URL is allowed by its origin's robots.txt, loading it on first use.
+    bool is_allowed_by_robots(const std::string& url);
+
+    // Non-blocking variant for the event loop: nullopt while the origin's robots.txt is not cached,
+    // in which case it is loaded in the background and the caller asks again later.
+    std::optional<bool> try_is_allowed_by_robots(const std::string& url);
+
+    // Non-blocking, for the event loop: true once begin_fetch(url) will not wait on a DNS lookup.
+    // Otherwise the lookup starts in the background and the caller asks again later.
+    bool dns_ready(const std::string& url);
+
+    // Persist cache metadata (cache/meta.json), robots (cache/robots.json), permanent redirects
+    // (cache/redirects.json) and the page index.
+    // Also done on destruction.
+    void flush_cache();
 
-    // Check whether URL is allowed by robots (call after fetch_robots for that host).
-    bool is_allowed_by_robots(const std::string& url) const;
+    // HTML cached for normalized_url, whether or not it is still fresh (used on resume to
+    // reload pages crawled before a checkpoint). nullopt if it is not in the cache.
+    std::optional<std::string> cached_page(const std::string& normalized_url) const;
 
     // Normalize and dedupe: returns true if url was new and should be crawled.
     bool seen_add(const std::string& normalized_url);
 
     const RunConfig& config() const { return config_; }
+    docscraper::fetch::RateLimiter& rate_limiter() { return rate_limiter_; }
+    RedirectMap& redirects() { return redirects_; }
+    const std::string& user_agent() const { return user_agent_; }
 
 private:
     RunConfig config_;
     docscraper::fetch::RateLimiter rate_limiter_;
-    docscraper::fetch::RobotsHandler robots_;
-    std::string robots_origin_;  // scheme+authority for which robots was loaded
-    std::unordered_set<std::string> seen_urls_;
-    mutable std::string cache_dir_;
+    ConnectionPool pool_;        // keep-alive clients per origin
+    RobotsCache robots_cache_;   // robots.txt per origin
+    DnsCache dns_;               // resolved addresses per host
+    std::mutex robots_fetch_mutex_;  // guards robots_loading_, robots_prefetch_
+    std::unordered_map<std::string, std::shared_future<RobotsCache::EntryPtr>> robots_loading_;  // origin -> download
+    std::vector<std::future<void>> robots_prefetch_;  // background loads from try_is_allowed_by_robots
+    std::map<std::string, int64_t> crawl_delay_applied_;  // origin -> fetched_at of the applied robots
+    docscraper::utils::UrlSeenSet seen_urls_;
+    mutable std::mutex mutex_;   // guards crawl_delay_applied_, seen_urls_
+    mutable PageStore page_store_;  // cached HTML, packed segments under cache/pages
+    CacheMetaStore cache_meta_;     // validators and fetch time per cached URL
+    RedirectMap redirects_;         // known permanent redirects
     std::string user_agent_;
 
-    std::string cache_path_for(const std::string& normalized_url) const;
+    FetchResponse request(const FetchTarget& target);
+    bool pin_addresses(const std::string& host, std::vector<std::string>& addresses, std::string& error);
+    RobotsCache::EntryPtr robots_entry(const docscraper::parse::URLComponents& parsed);
+    RobotsCache::EntryPtr download_robots(const std::string& origin);
+    bool resource_target(const std::string& url, FetchTarget& target, std::string& error);
+    std::shared_ptr<const docscraper::fetch::RobotsHandler> robots_for(const docscraper::parse::URLComponents& parsed);
+    void apply_crawl_delay(const std::string& origin, const std::string& host, const RobotsCache::Entry& robots);
+    bool in_cache(const std::string& normalized_url) const;
     bool load_from_cache(const std::string& normalized_url, std::string& out_html) const;
     void save_to_cache(const std::string& normalized_url, const std::string& html);
 };
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace scrapellm {
+
+// Crawl queue with bounded memory.
+//
+// Entries are grouped in buckets by (score, depth), each FIFO. Scores are rounded to whole
+// numbers for this, so continuous scores cannot make a bucket (and spill segments) per URL. In
+// BFS order scores are ignored, so the shallowest bucket drains first. In best-first order the
+// highest score drains first, then the shallowest, then the oldest. When every score is equal,
+// best-first is the same as BFS. Pagination entries are ordered by score in both orders, so a
+// high score puts them first.
+//
+// A bucket is an in-memory head, a run of on-disk segments, and an in-memory tail. Once more
+// than max_in_memory entries are held, the buckets that will be popped last are written out
+// as sequential segment files under spill_dir. A bucket reloads one segment at a time when its
+// head runs dry. Memory therefore stays bounded however large the frontier grows: at most
+// max_in_memory entries plus one reloaded segment (max_in_memory / 8). If a spill file cannot
+// be written, entries simply stay in memory.
+//
+// Not thread-safe; the Crawler guards it with its mutex.
+class CrawlFrontier {
+public:
+    struct Entry {
+        std::string url;
+        int depth = 0;
+        int64_t lastmod = 0;  // sitemap lastmod, Unix seconds (0 = unknown)
+        double score = 0.0;   // LinkScorer relevance; ignored in BFS order
+        int pagination = 0;   // pagination links followed in a row to reach this URL
+    };
+
+    struct Options {
+        bool best_first = false;
+        size_t max_in_memory = 200000;  // entries; 0 = unbounded (never spill)
+        std::string spill_dir;          // empty = never spill
+    };
+
+    explicit CrawlFrontier(Options options);
+    ~CrawlFrontier();
+
+    CrawlFrontier(const CrawlFrontier&) = delete;
+    CrawlFrontier& operator=(const CrawlFrontier&) = delete;
+
+    void push(Entry entry);
+    Entry pop();  // precondition: !empty()
+    void clear();  // drops every entry and deletes its spilled segments
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t in_memory() const { return in_memory_; }
+    size_t buckets() const { return buckets_.size(); }
+    bool best_first() const { return options_.best_first; }
+
+    // Visit the frontier in pop order (for checkpoints). Spilled segments are not read: each is
+    // handed to on_segment as its file and entry count instead. Stops and returns false as soon
+    // as on_segment does.
+    bool for_each(const std::function<void(const Entry&)>& on_entry,
+                  const std::function<bool(const std::string& path, size_t count)>& on_segment) const;
+
+    // Append the count entries of a segment file to out; false (out untouched) if it is short.
+    static bool read_segment(const std::string& path, size_t count, std::deque<Entry>& out);
+
+private:
+    struct Segment {
+        std::string path;
+        size_t count = 0;
+    };
+    struct Bucket {
+        std::deque<Entry> head;       // next out
+        std::deque<Segment> spilled;  // older than tail, newer than head
+        std::deque<Entry> tail;       // newest; only used while spilled is non-empty
+    };
+    // (score, depth); ordered so the first bucket is popped next.
+    using Key = std::pair<double, int>;
+    struct KeyOrder {
+        bool operator()(const Key& a, const Key& b) const {
+            if (a.first != b.first) return a.first > b.first;
+            return a.second < b.second;
+        }
+    };
+
+    Options options_;
+    size_t segment_entries_;
+    std::map<Key, Bucket, KeyOrder> buckets_;
+    size_t size_ = 0;
+    size_t in_memory_ = 0;
+    uint64_t next_segment_ = 0;
+    bool spill_failed_ = false;
+
+    Key key_of(const Entry& e) const;
+    void enforce_budget(const Bucket* keep);
+    bool spill_entries(std::deque<Entry>& from, bool from_front, Bucket& bucket, bool to_front);
+    bool write_segment(const std::vector<Entry>& entries, Segment& segment);
+};
+
+} // namespace scrapellm
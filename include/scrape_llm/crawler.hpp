@@ -0,0 +1,109 @@
+#pragma once
+
+#include "scrape_llm/checkpoint.hpp"
+#include "scrape_llm/cli_config.hpp"
+#include "scrape_llm/crawl_fetcher.hpp"
+#include "scrape_llm/crawl_frontier.hpp"
+#include "scrape_llm/link_classifier.hpp"
+#include "scrape_llm/link_graph.hpp"
+#include "scrape_llm/link_scorer.hpp"
+#include "scrape_llm/url_template.hpp"
+#include "utils/url_seen_set.hpp"
+#include "scrape_llm/types.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace scrapellm {
+
+// Crawl from config.url over the same origin, optionally seeded from the site's sitemaps. The
+// frontier is BFS or, with crawl_order "best-first", ordered by the LinkScorer's relevance of each
+// link to the schema. With the httplib backend, config.crawl_workers threads share one
+// CrawlFetcher; with "curl-multi", one thread drives many transfers through CurlMultiFetcher.
+// Each page's HTML is parsed once, outside the crawl lock, and released once its content and
+// links are taken; the results carry content only.
+class Crawler {
+public:
+    Crawler(const RunConfig& config, CrawlFetcher& fetcher, LinkScorer scorer = LinkScorer(),
+            Checkpoint* checkpoint = nullptr);
+
+    // Load the checkpoint's frontier, seen-set, crawled pages (HTML from the page cache) and
+    // counters into report. False if there is no matching checkpoint; the crawl then starts fresh.
+    // With a Checkpoint, run() saves crawl state every config.checkpoint_interval_s seconds and
+    // once the crawl ends.
+    bool restore(RunReport& report);
+
+    // For list-mode schemas: links to the next page of a listing are queued at the listing's own
+    // depth ahead of everything else, and followed past max_depth for up to config.max_pagination
+    // pages in a row, so whole catalogs are collected without a deeper crawl. Off by default.
+    void set_follow_pagination(bool on) { max_pagination_ = on ? config_.max_pagination : 0; }
+
+    // A link's predicted chance of leading to a kept page adds to its best-first score; with
+    // config.skip_predicted, links predicted SKIP with that confidence are not fetched
+    // (pagination links always are). Ignored until the model is ready().
+    void set_link_classifier(const LinkClassifier* model) { link_model_ = model && model->ready() ? model : nullptr; }
+
+    // Crawl until the frontier drains or max_pages pages succeed. Updates report (pages, errors).
+    // Results hold each page's ExtractedContent; their html is empty.
+    std::vector<CrawlResult> run(RunReport& report);
+
+    // Links between the pages crawled (empty unless config.link_graph), including pages at
+    // max_depth whose links are not followed; complete once run() returns. In best-first order, a
+    // queued URL is pushed again with a higher score each time its in-degree doubles, so pages many
+    // others link to are fetched sooner; the stale entry is dropped when popped.
+    const LinkGraph& graph() const { return graph_; }
+
+private:
+    using QueuedUrl = CrawlFrontier::Entry;
+
+    const RunConfig& config_;
+    CrawlFetcher& fetcher_;
+    LinkScorer scorer_;
+    TemplatePolicy template_policy_;
+    int max_pagination_ = 0;
+    const LinkClassifier* link_model_ = nullptr;
+    Checkpoint* checkpoint_;
+    std::string base_origin_;
+    std::set<std::string> origins_;  // in scope: base_origin_ and origins the start URL redirected to
+    bool restored_ = false;
+    bool restored_done_ = false;  // restored crawl had already finished
+    std::chrono::steady_clock::time_point run_start_;
+    std::chrono::steady_clock::time_point next_checkpoint_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    CrawlFrontier queue_;
+    docscraper::utils::UrlSeenSet queued_;  // normalized URLs ever enqueued
+    docscraper::utils::UrlSeenSet pages_;   // canonical and final URLs of crawled pages
+    docscraper::utils::UrlSeenSet dispatched_;  // normalized URLs popped from the frontier
+    LinkGraph graph_;
+    int in_flight_ = 0;
+    std::map<std::string, QueuedUrl> in_flight_urls_;  // by url; re-queued by a checkpoint
+    std::vector<CrawlResult> crawled_;
+    RunReport* report_ = nullptr;
+
+    void seed_from_sitemaps();
+    void worker_loop();
+    void run_event_loop();
+    bool finished_locked() const;
+    bool claim(CrawlResult& res);
+    std::vector<LinkContext> parse_page(CrawlResult& res, bool want_links) const;
+    std::vector<LinkContext> analyze_page(CrawlResult& res) const;
+    void count_transfer_locked(const CrawlResult& res);
+    void record_locked(std::optional<CrawlResult> res, const std::vector<LinkContext>& links);
+    TemplateStats& template_stats_locked(const std::string& url);
+    bool admit_locked(const QueuedUrl& qu);
+    bool pop_locked(QueuedUrl& qu);
+    void add_to_graph_locked(const std::string& page_url, const std::vector<LinkContext>& links);
+    void boost_locked(const LinkContext& link, int depth);
+    void enqueue_links_locked(const std::vector<LinkContext>& links, int depth, int pagination);
+    bool enqueue_locked(const std::string& url, int depth, int64_t lastmod, double score, int pagination = 0);
+    void maybe_checkpoint_locked();
+    void checkpoint_locked(bool done);
+};
+
+} // namespace scrapellm
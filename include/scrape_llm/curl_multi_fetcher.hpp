@@ -0,0 +1,81 @@
+#pragma once
+
+#include "scrape_llm/crawl_fetcher.hpp"
+#include "fetch/host_scheduler.hpp"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scrapellm {
+
+// Event-driven fetch backend on libcurl's multi interface (curl_multi_socket_action + poll).
+// Keeps up to max_in_flight transfers open from a single thread. SSRF, cache and result
+// handling come from the shared CrawlFetcher; redirects are re-queued as new requests through
+// CrawlFetcher::redirect_target rather than followed by libcurl. Nothing here blocks on the network
+// outside libcurl: a request is parked until its host's DNS lookup (and, for a redirect hop, its
+// origin's robots.txt) has finished in the background. Requests then wait in per-host queues; a
+// HostScheduler over the fetcher's RateLimiter releases hosts as their slots come due.
+class CurlMultiFetcher {
+public:
+    using Completion = std::function<void(CrawlResult)>;
+
+    CurlMultiFetcher(CrawlFetcher& fetcher, int max_in_flight);
+    ~CurlMultiFetcher();
+
+    CurlMultiFetcher(const CurlMultiFetcher&) = delete;
+    CurlMultiFetcher& operator=(const CurlMultiFetcher&) = delete;
+
+    // Queue a URL. Cached or blocked URLs complete on the next poll() without network I/O.
+    // lastmod is the sitemap hint passed to CrawlFetcher::begin_fetch.
+    void submit(const std::string& url, int depth, int64_t lastmod = 0);
+
+    // Drive transfers for at most timeout and call on_complete once per finished request.
+    void poll(std::chrono::milliseconds timeout, const Completion& on_complete);
+
+    // Requests submitted but not yet completed.
+    size_t pending() const { return parked_.size() + waiting_count_ + ready_.size() + transfers_.size(); }
+
+private:
+    struct Transfer;
+    struct Callbacks;  // libcurl socket/timer callbacks
+    struct Waiting { std::string url; int depth; FetchTarget target; int hops = 0; };
+    // Before begin_fetch: fetch_url is url itself or, after a redirect, the hop target.
+    struct Parked {
+        std::string url;
+        int depth = 0;
+        int64_t lastmod = 0;
+        std::string fetch_url;
+        int hops = 0;
+        FetchTarget from;        // the response that redirected here
+        bool robots_checked = true;
+    };
+
+    CrawlFetcher& fetcher_;
+    int max_in_flight_;
+    void* multi_ = nullptr;  // CURLM*
+    std::set<Transfer*> transfers_;   // in flight, owned
+    std::unordered_map<std::string, std::deque<Waiting>> waiting_;  // per host, submit order
+    size_t waiting_count_ = 0;
+    docscraper::fetch::HostScheduler scheduler_;  // hosts with waiting requests
+    std::vector<Parked> parked_;      // waiting on a background robots.txt or DNS lookup
+    std::vector<CrawlResult> ready_;  // completed without network
+    std::map<int, int> sockets_;      // socket -> CURL_POLL_* mask
+    long timer_ms_ = -1;              // libcurl's requested timeout, -1 = none
+    std::chrono::steady_clock::time_point timer_set_at_;
+
+    void socket_action(int s, int ev_bitmask);
+    void enqueue(Waiting w);
+    void start_parked();
+    void start_ready_transfers(std::chrono::steady_clock::time_point now);
+    void start_transfer(Waiting w);
+    void collect_completed(const Completion& on_complete);
+    std::chrono::milliseconds next_wait(std::chrono::steady_clock::time_point now,
+                                        std::chrono::milliseconds cap) const;
+};
+
+} // namespace scrapellm
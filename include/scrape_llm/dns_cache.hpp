@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scrapellm {
+
+// Resolved addresses per host name, shared by all fetches. Thread-safe.
+//
+// Each host is looked up once per ttl: concurrent callers for the same host wait on the one
+// getaddrinfo call. The system resolver does not expose record TTLs, so a fixed ttl is used.
+// Failed lookups are kept for negative_ttl so a dead host is not queried per URL.
+// try_resolve is the non-blocking form for the event loop: a miss starts the lookup on a
+// background thread.
+class DnsCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::chrono::seconds ttl{300};
+        std::chrono::seconds negative_ttl{30};
+    };
+
+    struct Result {
+        std::vector<std::string> addresses;  // numeric IPv4/IPv6, resolver order, no duplicates
+        std::string error;                   // set when the lookup failed
+
+        bool ok() const { return !addresses.empty(); }
+    };
+
+    explicit DnsCache(Options options);
+    ~DnsCache();
+
+    DnsCache(const DnsCache&) = delete;
+    DnsCache& operator=(const DnsCache&) = delete;
+
+    // Addresses for host (a name or an IP literal; IPv6 may be bracketed). Blocks on a miss.
+    Result resolve(const std::string& host);
+
+    // The cached result for host, or nullopt while it is being looked up in the background
+    // (started by this call on a miss or after expiry).
+    std::optional<Result> try_resolve(const std::string& host);
+
+private:
+    struct Entry {
+        std::shared_future<Result> result;
+        Clock::time_point expires;  // max() while the lookup is in flight
+    };
+
+    Options options_;
+    std::mutex mutex_;  // guards entries_, background_
+    std::unordered_map<std::string, Entry> entries_;
+    std::vector<std::future<void>> background_;  // lookups started by try_resolve
+
+    static std::string unbracket(const std::string& host);
+    static Result lookup(const std::string& host);
+    Result complete(const std::string& name, std::promise<Result>& promise);
+};
+
+} // namespace scrapellm
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "scrape_llm/relevance_router.hpp"
+#include "scrape_llm/types.hpp"
+#include <map>
+#include <string>
+
+namespace scrapellm {
+
+// Results of the LLM stages per page, kept across runs for --incremental (out/cache/records.jsonl).
+//
+// Each entry holds a hash of the page's extracted content (content_hash), the relevance decision
+// made for that content and, if the page was parsed, its records. A later run looks a page up
+// with its current hash: a match means the page is unchanged and its previous results can be
+// reused without calling the LLM. The file is tagged with a key of the schema the records were
+// extracted for; a different key discards it. Entries for pages not crawled again are kept.
+//
+// Not thread-safe.
+class IncrementalStore {
+public:
+    struct Entry {
+        std::string content_hash;
+        RelevanceDecision decision;
+        bool parsed = false;  // kept and parsed; page holds the records
+        ParsedPage page;
+    };
+
+    IncrementalStore(const std::string& out_dir, std::string schema_key);
+
+    // Read entries from a previous run with the same schema key; returns how many.
+    size_t load();
+    // Rewrite the file with the current entries (via a temporary file). False on a write error.
+    bool save() const;
+
+    // Previous results for url, if its content is unchanged.
+    const Entry* unchanged(const std::string& url, const std::string& content_hash) const;
+
+    // A relevance decision for this content replaces anything stored for the URL.
+    void record_relevance(const std::string& url, const std::string& content_hash, const RelevanceDecision& decision);
+    void record_parsed(const std::string& url, const std::string& content_hash, const ParsedPage& page);
+
+    size_t size() const { return entries_.size(); }
+
+    // Hash identifying the extracted content of a page (title, description, headings, text, tables).
+    static std::string content_hash(const ExtractedContent& content);
+
+private:
+    std::string path_;
+    std::string schema_key_;
+    std::map<std::string, Entry> entries_;
+};
+
+} // namespace scrapellm
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "scrape_llm/link_scorer.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scrapellm {
+
+// Online logistic regression predicting whether the relevance stage will keep the page a link
+// leads to (out/cache/link_model.json).
+//
+// Features are hashed into a fixed weight table: the link's URL template, path words, query
+// keys and anchor words. The model learns one SGD step per relevance decision as it arrives. A
+// decided page is trained on as the link that reached it would look, with the page title
+// standing in for the anchor text. Decisions are made after the crawl, so what a run learns
+// steers the frontier of the next or resumed crawl of the same site.
+//
+// The file is tagged with a key of the schema, like IncrementalStore; a different key starts
+// untrained. predict() may be called from several threads at once, but not during update().
+class LinkClassifier {
+public:
+    LinkClassifier(const std::string& out_dir, std::string schema_key);
+
+    // Read the weights of a previous run with the same schema key; returns its example count.
+    int64_t load();
+    // Rewrite the file (via a temporary file). False on a write error.
+    bool save() const;
+
+    // Probability that the page behind link is kept; 0.5 until ready().
+    double predict(const LinkContext& link) const;
+    // Trained on at least kMinExamples pages kept and kMinExamples skipped.
+    bool ready() const { return kept_ >= kMinExamples && skipped_ >= kMinExamples; }
+
+    // One SGD step towards the decision made for the page at url with this title.
+    void update(const std::string& url, const std::string& title, bool keep);
+
+    int64_t examples() const { return kept_ + skipped_; }
+
+    static constexpr int64_t kMinExamples = 5;
+
+private:
+    std::string path_;
+    std::string schema_key_;
+    std::vector<float> weights_;
+    int64_t kept_ = 0;
+    int64_t skipped_ = 0;
+
+    double probability(const std::vector<uint32_t>& features) const;
+};
+
+} // namespace scrapellm
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scrapellm {
+
+// Links between crawled pages, for in-degree and PageRank.
+//
+// URLs (normalized) are interned to dense uint32 ids, stored once in a shared buffer. Each
+// crawled page adds one row of out-links in compressed sparse row form: row_offsets_ indexes
+// targets_, and row_node_ names the page a row belongs to. Rows are appended in crawl order, so
+// the structure grows without rebuilding; in-degrees are kept up to date as rows arrive.
+// About 4 bytes per link plus the URL text, so large crawls stay cheap.
+//
+// Not thread-safe; the Crawler guards it with its mutex.
+class LinkGraph {
+public:
+    // Id of url, added as a node if new.
+    uint32_t intern(const std::string& url);
+    std::optional<uint32_t> find(const std::string& url) const;
+    const std::string& url(uint32_t id) const { return urls_[id]; }
+
+    // Record the out-links of the crawled page at url. Repeated links and links to the page
+    // itself are dropped; a page already recorded is ignored.
+    void add_page(const std::string& url, const std::vector<std::string>& links);
+
+    // Crawled pages linking to url (0 if unknown).
+    uint32_t in_degree(const std::string& url) const;
+    uint32_t in_degree(uint32_t id) const { return in_degree_[id]; }
+
+    size_t nodes() const { return urls_.size(); }
+    size_t pages() const { return row_node_.size(); }
+    size_t edges() const { return targets_.size(); }
+
+    // PageRank of every node, indexed by id, summing to 1. Pages without out-links, and nodes
+    // not crawled, spread their rank evenly over all nodes.
+    std::vector<double> pagerank(int iterations = 20, double damping = 0.85) const;
+
+    // Write dir/nodes.tsv (id, url, crawled, in_degree, out_degree, pagerank) and dir/edges.tsv
+    // (source id, target id) for offline analysis. False on a write error.
+    bool write_tsv(const std::string& dir) const;
+
+private:
+    std::unordered_map<uint64_t, uint32_t> ids_;  // fingerprint64 of the URL -> id
+    std::vector<std::string> urls_;
+    std::vector<uint32_t> in_degree_;
+    std::vector<int32_t> row_of_;        // node id -> its row, -1 if not crawled
+    std::vector<uint32_t> row_node_;     // row -> node id
+    std::vector<uint64_t> row_offsets_{0};
+    std::vector<uint32_t> targets_;
+};
+
+} // namespace scrapellm
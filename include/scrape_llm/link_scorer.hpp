@@ -0,0 +1,51 @@
+#pragma once
+
+#include "scrape_llm/types.hpp"
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace scrapellm {
+
+// A discovered link and the page text around it.
+struct LinkContext {
+    std::string url;      // absolute
+    std::string anchor;   // anchor text, or the alt/title of a link without text
+    std::string heading;  // nearest h1-h6 before the link
+    double score = 0.0;   // set by the Crawler from LinkScorer::score
+    std::string rel{};    // rel attribute ("next" on pager links)
+    bool pagination = false;  // leads to the next page of a listing, set by the Crawler
+    double keep_probability = 0.5;  // LinkClassifier prediction, set by the Crawler
+};
+
+// Lexical relevance of a link to the extraction goal, used by the best-first frontier.
+//
+// Keywords come from the schema description, hints.key_fields and the property names of the
+// inferred JSON schema. A link earns points for keywords in its anchor text (3), URL path and
+// query (2) and heading (1), and loses 2 when its path or anchor looks like site boilerplate
+// (legal, login, blog, ...). Words are lowercased, split on punctuation and camelCase, and
+// plurals folded, so "productPrice" matches "/products/price". Without keywords every link
+// scores 0.
+class LinkScorer {
+public:
+    LinkScorer() = default;
+    LinkScorer(const std::string& schema_description, const InferredSchema& schema);
+
+    double score(const LinkContext& link) const;
+
+    // Whether a fetched page's text mentions enough of the keywords (a third of them, at least 1
+    // and at most 3) to look like it holds the data. Always false without keywords.
+    bool matches_page(const std::string& text) const;
+
+    const std::unordered_set<std::string>& keywords() const { return keywords_; }
+
+    // Lowercased, singularized word tokens of text, without stopwords and numbers.
+    static std::vector<std::string> tokenize(const std::string& text);
+
+private:
+    std::unordered_set<std::string> keywords_;
+
+    int hits(const std::vector<std::string>& tokens) const;
+};
+
+} // namespace scrapellm
@@ -17,4 +17,7 @@ void write_outputs(
 // Write schema to out_dir/schema.json.
 void write_schema(const std::string& out_dir, const nlohmann::json& schema_obj);
 
+// Read out_dir/schema.json back; false if missing or not valid JSON.
+bool read_schema(const std::string& out_dir, nlohmann::json& schema_obj);
+
 } // namespace scrapellm
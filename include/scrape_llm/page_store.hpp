@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace scrapellm {
+
+// Append-only page cache: zlib-compressed records packed into segment files (seg-NNNNNN.pack)
+// with an in-memory 64-bit fingerprint index, snapshotted to index.bin.
+//
+// Each record carries its key and a CRC32, so a torn append from a crash is detected and cut
+// off on the next open; the index snapshot is replaced atomically. When live data exceeds
+// max_bytes, least-recently-used pages are evicted (leaving a tombstone record so a rescan
+// does not bring them back), and sealed segments that are mostly dead are compacted into the
+// active one. Thread-safe.
+class PageStore {
+public:
+    struct Options {
+        std::string dir;
+        uint64_t max_bytes = 0;                 // live-data budget; 0 = unbounded
+        uint64_t segment_bytes = 64ull << 20;   // rotate the active segment past this size
+    };
+
+    struct Stats {
+        size_t entries = 0;
+        uint64_t live_bytes = 0;   // records reachable from the index
+        uint64_t file_bytes = 0;   // total segment size on disk
+        size_t segments = 0;
+    };
+
+    explicit PageStore(Options options);
+    ~PageStore();
+
+    PageStore(const PageStore&) = delete;
+    PageStore& operator=(const PageStore&) = delete;
+
+    bool contains(const std::string& key) const;
+    std::optional<std::string> get(const std::string& key);
+    bool put(const std::string& key, const std::string& value);
+
+    // Write the index snapshot (temp file + rename).
+    bool flush();
+
+    Stats stats() const;
+
+private:
+    struct Location {
+        uint32_t segment = 0;
+        uint32_t length = 0;     // whole record, header included
+        uint64_t offset = 0;
+        uint64_t last_access = 0;
+    };
+    struct Tombstone {
+        uint32_t segment = 0;
+        uint32_t length = 0;
+        uint64_t offset = 0;
+    };
+    struct Segment {
+        int fd = -1;
+        uint64_t size = 0;
+        uint64_t live = 0;
+    };
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Location> index_;
+    std::unordered_map<uint64_t, Tombstone> tombstones_;
+    std::map<uint32_t, Segment> segments_;
+    uint32_t active_ = 0;
+    uint64_t live_bytes_ = 0;
+    uint64_t clock_ = 0;
+    bool dirty_ = false;
+
+    std::string segment_path(uint32_t id) const;
+    std::string index_path() const;
+    void open_locked();
+    bool load_index_locked(std::map<uint32_t, uint64_t>& covered);
+    void scan_segment_locked(uint32_t id, uint64_t from);
+    bool flush_locked();
+    Segment& active_segment_locked(uint64_t next_record);
+    bool append_locked(uint64_t fp, const std::string& record);
+    bool append_tombstone_locked(uint64_t fp, const std::string& record);
+    std::string read_key_locked(uint32_t segment, uint64_t offset);
+    void drop_locked(uint64_t fp);
+    void evict_locked();
+    void compact_locked();
+};
+
+} // namespace scrapellm
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "scrape_llm/link_scorer.hpp"
+#include <string>
+
+namespace scrapellm {
+
+// Page number a listing URL carries: the value of a page query parameter (page, p, pg, paged,
+// pagenum, page_num, pageno) or of a "/page/N" path segment pair; -1 if there is none.
+int url_page_number(const std::string& url);
+
+// Whether link leads to a later page of the listing at page_url. It does when it is
+// rel="next"; when it is page_url with a higher page number (no number counts as page 1); or,
+// on the same path and without a page number of its own (cursor links), when its anchor reads
+// "next" (or ›, », →) or is a page number above the current one. For example "/list?page=3"
+// from "/list?page=2", and "/blog/page/2" from "/blog".
+bool is_pagination_link(const LinkContext& link, const std::string& page_url);
+
+// Whether page_url may be keyed by its rel=canonical. Listings often point every page's canonical
+// at page 1; a page reached through pagination, or whose canonical is another page of its own
+// listing, keeps its own URL so that it is not dropped as an alias before its next link is read.
+bool canonical_applies(const std::string& canonical, const std::string& page_url, int pagination);
+
+} // namespace scrapellm
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace scrapellm {
+
+// Permanent redirects (301, 308) seen while crawling, keyed by normalized URL and persisted as
+// cache/redirects.json. URLs are rewritten through it before they are queued, so a known alias
+// is fetched as its target directly, in this run and later ones. Thread-safe.
+class RedirectMap {
+public:
+    // Loads path if it exists; a missing or unreadable file starts empty.
+    explicit RedirectMap(std::string path);
+
+    // Remember from -> to; a later redirect for the same URL replaces it. from == to is ignored.
+    void record(const std::string& from, const std::string& to);
+
+    // Follow recorded redirects from normalized_url; the URL itself if there are none. Stops
+    // after kMaxHops or on a loop, returning the last URL reached.
+    std::string resolve(const std::string& normalized_url) const;
+
+    size_t size() const;
+
+    // Write to disk (temp file + rename) if anything changed since the last save.
+    bool save();
+
+    static constexpr int kMaxHops = 10;
+
+private:
+    std::string path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, std::string> targets_;
+    bool dirty_ = false;
+};
+
+// True for the statuses whose target may be remembered (301 Moved Permanently, 308 Permanent Redirect).
+inline bool is_permanent_redirect(int status) { return status == 301 || status == 308; }
+
+// True for a status that is followed when it comes with a Location (301, 302, 303, 307, 308).
+inline bool is_followed_redirect(int status) {
+    return status == 301 || status == 302 || status == 303 || status == 307 || status == 308;
+}
+
+} // namespace scrapellm
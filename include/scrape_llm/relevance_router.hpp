@@ -2,6 +2,7 @@
 
 #include "scrape_llm/types.hpp"
 #include "scrape_llm/llm_client.hpp"
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -10,6 +11,7 @@ namespace scrapellm {
 struct RelevanceDecision {
     bool keep = false;
     std::string reason;
+    bool llm_failed = false;  // no answer from the LLM; not memoized, so a resumed run asks again
 };
 
 // LLM decides KEEP or SKIP for a page digest.
@@ -19,12 +21,21 @@ RelevanceDecision relevance_decide(
     const PageDigest& digest
 );
 
-// From crawled pages with digests, select top keep_n by relevance (LLM score/decision).
+// Decisions already made for page URLs (e.g. by an interrupted run), and where to store new ones.
+struct RelevanceMemo {
+    std::function<const RelevanceDecision*(const std::string& url)> lookup;
+    std::function<void(const std::string& url, const RelevanceDecision& decision)> record;
+};
+
+// From crawled pages with digests, select top keep_n by relevance (LLM score/decision). When
+// more than keep_n are kept, those with the highest PageDigest::rank are selected.
+// With a memo, pages it already has a decision for are not sent to the LLM again.
 std::vector<PageDigest> select_pages_to_parse(
     ILlmClient& client,
     const std::string& user_schema,
     std::vector<PageDigest> digests,
-    int keep_n
+    int keep_n,
+    const RelevanceMemo* memo = nullptr
 );
 
 } // namespace scrapellm
@@ -5,6 +5,14 @@
 
 namespace scrapellm {
 
+// RunReport as written to report.json, and back (used by checkpoints).
+nlohmann::json report_to_json(const RunReport& report);
+RunReport report_from_json(const nlohmann::json& j);
+
+// ParsedPage as stored by checkpoints and the incremental store.
+nlohmann::json parsed_page_to_json(const ParsedPage& page);
+ParsedPage parsed_page_from_json(const nlohmann::json& j);
+
 // Write report.json and report.md under out_dir.
 void write_report(const std::string& out_dir, const RunReport& report);
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "fetch/robots.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace scrapellm {
+
+// robots.txt per origin (scheme://host[:port]), persisted as cache/robots.json. Thread-safe.
+//
+// A 200 is parsed and kept for ttl_s. Any 4xx means "no robots.txt" (everything allowed) and is
+// also kept for ttl_s. 5xx responses and network errors mean the site is unreachable, which
+// RFC 9309 treats as disallow-all; that is kept only for error_ttl_s, so the outage gets
+// retried soon.
+class RobotsCache {
+public:
+    struct Options {
+        std::string path;             // empty = memory only
+        int64_t ttl_s = 86400;
+        int64_t error_ttl_s = 300;
+    };
+
+    struct Entry {
+        int status = 0;               // HTTP status; 0 = network error
+        int64_t fetched_at = 0;       // unix seconds
+        std::string body;             // kept for persistence; empty unless status 200
+        std::shared_ptr<const docscraper::fetch::RobotsHandler> rules;  // never null
+    };
+    // Entries are immutable once made, so lookups share them instead of copying the body.
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    explicit RobotsCache(Options options);
+
+    // Fresh entry for origin, or nullptr when missing or expired.
+    EntryPtr get(const std::string& origin, int64_t now) const;
+
+    // Record a fetch result (status 0 for network errors) and return the parsed entry.
+    EntryPtr put(const std::string& origin, int status, std::string body, int64_t now);
+
+    // Write to disk (temp file + rename) if anything changed since the last save.
+    bool save();
+
+private:
+    Options options_;
+    mutable std::mutex mutex_;
+    std::map<std::string, EntryPtr> entries_;
+    bool dirty_ = false;
+
+    bool fresh(const Entry& e, int64_t now) const;
+    static EntryPtr make_entry(int status, std::string body, int64_t fetched_at);
+};
+
+} // namespace scrapellm
@@ -1,12 +1,23 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace scrapellm {
 
 // Returns true if the URL is allowed (http/https and not private/local when allow_private is false).
+// Only the literal host is checked here; see is_private_address for resolved addresses.
 bool url_allowed_ssrf(const std::string& url, bool allow_private_network);
 
+// Returns true if ip (numeric IPv4 or IPv6, optionally bracketed) is loopback, private, link-local,
+// unspecified, multicast or otherwise not a public unicast address. IPv4-mapped IPv6 is unwrapped.
+// Host names are not resolved; CrawlFetcher checks every resolved address with this.
+bool is_private_address(const std::string& ip);
+
+// The first of a host's resolved addresses that is_private_address rejects, or empty if all are
+// public. One private record is enough to refuse the host.
+std::string first_private_address(const std::vector<std::string>& addresses);
+
 // Returns true if scheme is http or https.
 bool is_http_or_https(const std::string& url);
 
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace scrapellm {
+
+// Incremental Content-Encoding decoder (gzip, deflate, and br when built with brotli).
+// Compressed chunks go in as they arrive off the wire; decoded bytes are handed to a sink,
+// so a page is never held in both forms at once.
+class StreamDecoder {
+public:
+    // Returns false to stop decoding (e.g. the decoded size cap was hit).
+    using Sink = std::function<bool(const char* data, size_t len)>;
+
+    virtual ~StreamDecoder() = default;
+
+    // Decode one chunk. False on corrupt input or when the sink refused data.
+    virtual bool write(const char* data, size_t len, const Sink& sink) = 0;
+
+    // True once the end of the compressed stream was decoded. False after the last chunk
+    // means the body was truncated.
+    virtual bool finished() const = 0;
+
+    // Decoder for a Content-Encoding header value; nullptr for identity or an unsupported coding
+    // (supports_encoding tells the two apart).
+    static std::unique_ptr<StreamDecoder> create(const std::string& content_encoding);
+
+    static bool supports_encoding(const std::string& content_encoding);
+
+    // Accept-Encoding value advertising every coding this build can decode.
+    static const char* accept_encoding();
+};
+
+} // namespace scrapellm
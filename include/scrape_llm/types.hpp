@@ -2,6 +2,7 @@
 
 #include <nlohmann/json.hpp>
 #include <chrono>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,7 @@ struct PageDigest {
     std::string title;
     std::vector<std::string> headings;
     std::string text_preview;
+    double rank = 0.0;  // PageRank in the crawl's link graph; orders kept pages
 };
 
 struct ExtractedContent {
@@ -31,9 +33,46 @@ struct ExtractedContent {
     std::vector<std::string> headings;    // h1, h2 (and optionally h3) in order
 };
 
+// Body bytes downloaded from one host: as transferred vs. after Content-Encoding decoding.
+struct HostTransferStats {
+    int pages = 0;
+    int64_t wire_bytes = 0;
+    int64_t decoded_bytes = 0;
+};
+
+// What parsing one page contributed to a run: its validated records and repair outcomes.
+struct ParsedPage {
+    std::vector<json> records;
+    int validation_failures = 0;
+    int repair_attempts = 0;
+    int repair_successes = 0;
+    std::vector<std::string> errors;
+};
+
+// Crawl counts for one URL template (see url_template): URLs queued, pages fetched, fetched
+// pages that matched the schema's keywords, and URLs passed over by the template policy.
+struct TemplateStats {
+    int queued = 0;
+    int fetched = 0;
+    int on_topic = 0;
+    int skipped = 0;
+};
+
+// A crawled page left out of the LLM stages because its text nearly matches an earlier page.
+struct DuplicatePage {
+    std::string url;
+    std::string duplicate_of;
+};
+
 struct RunReport {
     int pages_crawled = 0;
+    int pagination_pages = 0;  // crawled by following a listing's pagination
+    int links_predicted_skip = 0;  // links not fetched because the link model predicted SKIP
+    int links_boosted = 0;     // queued URLs moved up the frontier as more pages linked to them
+    int64_t graph_urls = 0;    // link graph: crawled and linked URLs
+    int64_t graph_links = 0;   // link graph: distinct links between them
     int pages_kept = 0;
+    int pages_reused = 0;  // --incremental: unchanged since the last run, LLM results reused
     int records_emitted = 0;
     int validation_failures = 0;
     int repair_attempts = 0;
@@ -43,6 +82,12 @@ struct RunReport {
     std::chrono::milliseconds llm_ms{0};
     std::vector<std::string> errors;
     std::vector<std::string> pages_visited;
+    std::vector<DuplicatePage> duplicates;
+    // Page (canonical URL, else final URL after redirects) -> other URLs that served it. Aliases
+    // found after the fetch were dropped before parsing.
+    std::map<std::string, std::vector<std::string>> aliases;
+    std::map<std::string, HostTransferStats> transfer_by_host;
+    std::map<std::string, TemplateStats> templates;
 };
 
 } // namespace scrapellm
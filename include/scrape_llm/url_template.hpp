@@ -0,0 +1,37 @@
+#pragma once
+
+#include "scrape_llm/types.hpp"
+#include <string>
+
+namespace scrapellm {
+
+// Page type of a URL: its path and query with the parts that vary between pages of one type
+// masked. Path segments that are numbers become {num}, hex digests and UUIDs {hash}, mixed
+// letter-and-digit codes {id}, and hyphenated phrases of three or more words (or very long
+// segments) {slug}; a file extension is kept. Query keys are sorted and every value becomes
+// {num} or {val}. "/product/12345?ref=abc" -> "/product/{num}?ref={val}".
+std::string url_template(const std::string& url);
+
+// Whether the crawler fetches one more page of a template, from that template's stats.
+//
+// max_fetches caps the pages fetched per template. Once probe_fetches pages of a template have
+// been fetched without one on topic, only one in sample_every of its further URLs is fetched.
+// Either rule is off at 0.
+class TemplatePolicy {
+public:
+    struct Options {
+        int max_fetches = 0;
+        int probe_fetches = 0;
+        int sample_every = 10;
+    };
+
+    TemplatePolicy() = default;
+    explicit TemplatePolicy(Options options) : options_(options) {}
+
+    bool admit(const TemplateStats& stats) const;
+
+private:
+    Options options_;
+};
+
+} // namespace scrapellm
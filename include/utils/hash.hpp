@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,10 @@ std::string content_hash(const std::string& content);
 // Hash URL for use as database key (uses MD5 for shorter keys)
 std::string url_hash(const std::string& normalized_url);
 
+// Fast 64-bit non-cryptographic hash (MurmurHash64A) for in-memory indexes and fingerprints
+uint64_t fingerprint64(const void* data, size_t length, uint64_t seed = 0);
+uint64_t fingerprint64(const std::string& data, uint64_t seed = 0);
+
 // Convert binary hash to hex string
 std::string bytes_to_hex(const unsigned char* data, size_t length);
 std::string bytes_to_hex(const std::vector<unsigned char>& data);
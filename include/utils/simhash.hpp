@@ -0,0 +1,51 @@
+// simhash.hpp - Near-Duplicate Text Fingerprints
+// LLM Documentation Scraper - C++ Implementation
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace docscraper::utils {
+
+// 64-bit SimHash (Charikar) of text, from overlapping 3-word shingles of its lowercased words.
+// Texts that differ in a few words get fingerprints a few bits apart, so near-duplicates can be
+// found by Hamming distance. Returns 0 for text under kSimHashMinWords words, which is too short
+// to compare meaningfully.
+constexpr size_t kSimHashMinWords = 16;
+uint64_t simhash64(const std::string& text);
+
+int hamming_distance(uint64_t a, uint64_t b);
+
+// Finds a stored fingerprint within max_distance bits of a query. Fingerprints are split into
+// max_distance + 1 bit blocks; by the pigeonhole principle a match agrees exactly on at least one
+// block, so each block has its own exact-match table and only those candidates are compared.
+// Not thread-safe.
+class SimHashIndex {
+public:
+    explicit SimHashIndex(int max_distance = 3);  // clamped to [0, 63]
+
+    // id of the first inserted fingerprint within max_distance of fp, if any.
+    std::optional<size_t> find(uint64_t fp) const;
+    void insert(uint64_t fp, size_t id);
+
+    size_t size() const { return fingerprints_.size(); }
+
+private:
+    struct Block {
+        int shift = 0;
+        uint64_t mask = 0;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> table;  // block bits -> entries
+    };
+
+    int max_distance_;
+    std::vector<Block> blocks_;
+    std::vector<uint64_t> fingerprints_;
+    std::vector<size_t> ids_;
+};
+
+} // namespace docscraper::utils
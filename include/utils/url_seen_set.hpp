@@ -0,0 +1,68 @@
+// url_seen_set.hpp - Compact URL Dedup Set
+// LLM Documentation Scraper - C++ Implementation
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace docscraper::utils {
+
+// Set of URLs stored as 64-bit fingerprints (fingerprint64) in an open-addressing table with
+// linear probing. About 11-21 bytes per URL, depending on where the table sits between resizes,
+// versus 100+ for a node-based set of strings, and a lookup touches one or two cache lines.
+//
+// Two different URLs share a fingerprint with probability ~n/2^64 per lookup (under 1e-12 at
+// ten million URLs); such a URL would be reported as seen and skipped.
+//
+// With bloom_fp_rate > 0 a Bloom filter sized for expected_urls sits in front. It is small
+// enough to stay in cache, and answers "not seen" for new URLs without probing the table.
+// Its rate only decides how often a new URL still has to probe the table; it never changes
+// the answers. Past expected_urls the filter fills up and helps less, but stays correct.
+//
+// Not thread-safe; callers hold their own lock.
+class UrlSeenSet {
+public:
+    struct Options {
+        size_t expected_urls = 1 << 16;  // initial capacity; the table doubles beyond it
+        double bloom_fp_rate = 0.0;      // 0 = no Bloom front
+    };
+
+    UrlSeenSet();
+    explicit UrlSeenSet(Options options);
+
+    // Add url; returns true if it was not already present.
+    bool insert(const std::string& url);
+    bool contains(const std::string& url) const;
+
+    // Same, for callers that already hold the fingerprint (e.g. a checkpoint reload).
+    bool insert_fingerprint(uint64_t fp);
+    bool contains_fingerprint(uint64_t fp) const;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t memory_bytes() const;  // table plus Bloom filter
+    void clear();
+
+    static uint64_t fingerprint(const std::string& url);
+
+    // Stored fingerprints in table order, for persisting the set.
+    std::vector<uint64_t> fingerprints() const;
+
+private:
+    Options options_;
+    std::vector<uint64_t> slots_;  // 0 = empty
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    std::vector<uint64_t> bloom_;  // bit array
+    uint64_t bloom_bits_ = 0;
+    int bloom_hashes_ = 0;
+
+    void rehash(size_t capacity);
+    bool bloom_maybe(uint64_t fp) const;
+    void bloom_add(uint64_t fp);
+};
+
+} // namespace docscraper::utils
@@ -0,0 +1,38 @@
+// host_scheduler.cpp - Ready-Host Scheduler Implementation
+// LLM Documentation Scraper - C++ Implementation
+
+#include "fetch/host_scheduler.hpp"
+
+namespace docscraper::fetch {
+
+HostScheduler::HostScheduler(RateLimiter& limiter)
+    : limiter_(limiter) {}
+
+void HostScheduler::push(const std::string& host) {
+    if (!scheduled_.insert(host).second) return;
+    heap_.push({limiter_.earliest(host), seq_++, host});
+}
+
+std::optional<std::string> HostScheduler::pop_ready(Clock::time_point now) {
+    while (!heap_.empty() && heap_.top().at <= now) {
+        Item item = heap_.top();
+        heap_.pop();
+        // The limiter may have moved the host back since it was pushed (Retry-After,
+        // another caller reserving a slot); requeue at the new time.
+        auto at = limiter_.earliest(item.host);
+        if (at > now) {
+            heap_.push({at, seq_++, std::move(item.host)});
+            continue;
+        }
+        scheduled_.erase(item.host);
+        return std::move(item.host);
+    }
+    return std::nullopt;
+}
+
+std::optional<HostScheduler::Clock::time_point> HostScheduler::next_ready() const {
+    if (heap_.empty()) return std::nullopt;
+    return heap_.top().at;
+}
+
+} // namespace docscraper::fetch
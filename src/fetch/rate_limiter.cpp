@@ -2,6 +2,9 @@
 // LLM Documentation Scraper - C++ Implementation
 
 #include "fetch/rate_limiter.hpp"
+#include <algorithm>
+#include <cctype>
+#include <ctime>
 #include <thread>
 
 namespace docscraper::fetch {
@@ -16,58 +19,133 @@ void RateLimiter::set_host_delay(const std::string& host, std::chrono::milliseco
 
 std::chrono::milliseconds RateLimiter::get_host_delay(const std::string& host) const {
     std::lock_guard<std::mutex> lock(mutex_);
+    return delay_locked(host);
+}
+
+std::chrono::milliseconds RateLimiter::delay_locked(const std::string& host) const {
     auto it = host_delays_.find(host);
-    if (it != host_delays_.end()) {
-        return it->second;
-    }
-    return default_delay_;
+    auto fixed = (it != host_delays_.end()) ? it->second : default_delay_;
+    if (!adaptive_) return fixed;
+
+    auto state = adaptive_state_.find(host);
+    if (state == adaptive_state_.end()) return fixed;
+    auto adaptive = std::chrono::milliseconds(static_cast<int64_t>(1000.0 / state->second.rate));
+    // A host override (Crawl-delay) is a floor; the default delay is only the starting point
+    return (it != host_delays_.end()) ? std::max(adaptive, it->second) : adaptive;
 }
 
-void RateLimiter::reset_host(const std::string& host) {
+void RateLimiter::enable_adaptive(const AdaptiveRateOptions& options) {
     std::lock_guard<std::mutex> lock(mutex_);
-    last_request_.erase(host);
+    adaptive_ = true;
+    adaptive_options_ = options;
 }
 
-std::chrono::milliseconds RateLimiter::add_jitter(std::chrono::milliseconds delay) {
-    // Add +/- 10% jitter
-    int64_t base = delay.count();
-    int64_t jitter = static_cast<int64_t>(base * 0.1);
-    if (jitter <= 0) return delay;
+bool RateLimiter::adaptive() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return adaptive_;
+}
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int64_t> dist(-jitter, jitter);
-    return std::chrono::milliseconds(base + dist(gen));
+std::chrono::steady_clock::time_point RateLimiter::blocked_until(const std::string& host) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = blocked_until_.find(host);
+    return it != blocked_until_.end() ? it->second : std::chrono::steady_clock::time_point{};
 }
 
-void RateLimiter::wait_for_host(const std::string& host) {
-    std::chrono::milliseconds delay;
-    std::chrono::steady_clock::time_point last;
-    bool has_last = false;
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto delay_it = host_delays_.find(host);
-        delay = (delay_it != host_delays_.end()) ? delay_it->second : default_delay_;
-        auto last_it = last_request_.find(host);
-        if (last_it != last_request_.end()) {
-            last = last_it->second;
-            has_last = true;
-        }
-        last_request_[host] = std::chrono::steady_clock::now();
+void RateLimiter::record_response(const std::string& host, int status, std::chrono::milliseconds latency,
+                                  std::chrono::seconds retry_after) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (retry_after.count() > 0) {
+        auto until = std::chrono::steady_clock::now() + retry_after;
+        auto& blocked = blocked_until_[host];
+        blocked = std::max(blocked, until);
+    }
+    if (!adaptive_) return;
+
+    const auto& opt = adaptive_options_;
+    auto it = adaptive_state_.find(host);
+    if (it == adaptive_state_.end()) {
+        auto start = delay_locked(host);  // the fixed delay, as there is no state yet
+        AdaptiveState initial;
+        initial.rate = 1000.0 / static_cast<double>(std::max<int64_t>(start.count(), 1));
+        it = adaptive_state_.emplace(host, initial).first;
     }
+    AdaptiveState& st = it->second;
 
-    if (!has_last) {
-        return;  // First request, no wait
+    bool failed = status == 0 || status == 429 || status >= 500;
+    double ms = static_cast<double>(latency.count());
+    if (failed) {
+        st.rate *= opt.error_backoff;
+    } else if (st.samples >= 3 && ms > opt.latency_spike * st.latency_baseline_ms) {
+        st.rate *= opt.latency_backoff;
+    } else {
+        st.rate += opt.increase_rps;
     }
+    if (!failed) {
+        // Slow-moving baseline so a gradual rise still registers as a spike
+        st.latency_baseline_ms = st.samples == 0 ? ms : 0.9 * st.latency_baseline_ms + 0.1 * ms;
+        ++st.samples;
+    }
+
+    double max_rate = 1000.0 / static_cast<double>(std::max<int64_t>(opt.min_delay.count(), 1));
+    double min_rate = 1000.0 / static_cast<double>(std::max<int64_t>(opt.max_delay.count(), 1));
+    st.rate = std::clamp(st.rate, min_rate, max_rate);
+}
 
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last);
-    auto target_delay = add_jitter(delay);
+void RateLimiter::reset_host(const std::string& host) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_request_.erase(host);
+    next_jitter_.erase(host);
+    blocked_until_.erase(host);
+    adaptive_state_.erase(host);
+}
+
+std::chrono::steady_clock::time_point RateLimiter::earliest_locked(const std::string& host) const {
+    std::chrono::steady_clock::time_point slot{};
+    auto last_it = last_request_.find(host);
+    if (last_it != last_request_.end()) {
+        auto delay = delay_locked(host);
+        auto jitter_it = next_jitter_.find(host);
+        double factor = 1.0 + (jitter_it != next_jitter_.end() ? jitter_it->second : 0.0);
+        slot = last_it->second + std::chrono::milliseconds(static_cast<int64_t>(delay.count() * factor));
+    }
+    auto blocked_it = blocked_until_.find(host);
+    if (blocked_it != blocked_until_.end()) {
+        slot = std::max(slot, blocked_it->second);
+    }
+    return slot;
+}
+
+std::chrono::steady_clock::time_point RateLimiter::earliest(const std::string& host) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return earliest_locked(host);
+}
+
+std::chrono::steady_clock::time_point RateLimiter::reserve(const std::string& host) {
+    // The slot is recorded under the lock so concurrent callers for the
+    // same host are spaced out instead of all waking after one delay.
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto slot = std::max(std::chrono::steady_clock::now(), earliest_locked(host));
+    last_request_[host] = slot;
+    std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+    next_jitter_[host] = jitter(rng_);
+    return slot;
+}
+
+void RateLimiter::wait_for_host(const std::string& host) {
+    std::this_thread::sleep_until(reserve(host));
+}
 
-    if (elapsed < target_delay) {
-        std::this_thread::sleep_for(target_delay - elapsed);
+std::chrono::seconds parse_retry_after(const std::string& value, int64_t now_unix) {
+    if (value.empty()) return std::chrono::seconds(0);
+    int64_t seconds = 0;
+    if (std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        try { seconds = std::stoll(value); } catch (...) { return std::chrono::seconds(0); }
+    } else {
+        std::tm tm{};
+        if (!strptime(value.c_str(), "%a, %d %b %Y %H:%M:%S", &tm)) return std::chrono::seconds(0);
+        seconds = static_cast<int64_t>(timegm(&tm)) - now_unix;
     }
+    return std::chrono::seconds(std::clamp<int64_t>(seconds, 0, 600));
 }
 
 } // namespace docscraper::fetch
@@ -8,6 +8,95 @@
 
 namespace docscraper::fetch {
 
+uint32_t RobotsMatcher::child(uint32_t node, unsigned char c) const {
+    auto it = edges_.find((static_cast<uint64_t>(node) << 8) | c);
+    return it == edges_.end() ? kNone : it->second;
+}
+
+uint32_t RobotsMatcher::add_child(uint32_t node, unsigned char c) {
+    auto [it, inserted] = edges_.try_emplace((static_cast<uint64_t>(node) << 8) | c,
+                                             static_cast<uint32_t>(nodes_.size()));
+    if (inserted) nodes_.emplace_back();
+    return it->second;
+}
+
+void RobotsMatcher::add(const std::string& pattern, bool allow) {
+    if (pattern.empty()) return;  // "Disallow:" with no value matches nothing
+
+    bool anchored = pattern.back() == '$';
+    size_t end = anchored ? pattern.size() - 1 : pattern.size();
+    uint32_t node = 0;
+    for (size_t i = 0; i < end; ++i) {
+        if (pattern[i] == '*') {
+            if (i > 0 && pattern[i - 1] == '*') continue;  // "**" == "*"
+            has_star_ = true;
+            if (nodes_[node].star == kNone) {
+                nodes_[node].star = static_cast<uint32_t>(nodes_.size());
+                nodes_.emplace_back().self_loop = true;
+            }
+            node = nodes_[node].star;
+        } else {
+            node = add_child(node, static_cast<unsigned char>(pattern[i]));
+        }
+    }
+
+    // Priority is the pattern's length, as in the prefix matcher this replaces
+    int len = static_cast<int>(pattern.size());
+    Node& n = nodes_[node];
+    int& slot = anchored ? (allow ? n.allow_end : n.disallow_end) : (allow ? n.allow : n.disallow);
+    slot = std::max(slot, len);
+}
+
+RobotsMatcher::Result RobotsMatcher::match(const std::string& path) const {
+    Result r;
+    if (empty()) return r;
+
+    if (!has_star_) {
+        uint32_t node = 0;
+        for (unsigned char c : path) {
+            r.allow = std::max(r.allow, nodes_[node].allow);
+            r.disallow = std::max(r.disallow, nodes_[node].disallow);
+            node = child(node, c);
+            if (node == kNone) return r;
+        }
+        const Node& n = nodes_[node];
+        r.allow = std::max({r.allow, n.allow, n.allow_end});
+        r.disallow = std::max({r.disallow, n.disallow, n.disallow_end});
+        return r;
+    }
+
+    // Live states. Entering a node also enters its '*' child (which may match nothing); a '*'
+    // node stays live on every byte. Live sets stay tiny, so a linear duplicate check is enough.
+    std::vector<uint32_t> live;
+    std::vector<uint32_t> next;
+    auto enter = [&](std::vector<uint32_t>& set, uint32_t id) {
+        while (id != kNone && std::find(set.begin(), set.end(), id) == set.end()) {
+            set.push_back(id);
+            const Node& n = nodes_[id];
+            r.allow = std::max(r.allow, n.allow);
+            r.disallow = std::max(r.disallow, n.disallow);
+            id = n.star;
+        }
+    };
+
+    enter(live, 0);
+    for (unsigned char c : path) {
+        next.clear();
+        for (uint32_t id : live) {
+            if (nodes_[id].self_loop) enter(next, id);
+            uint32_t to = child(id, c);
+            if (to != kNone) enter(next, to);
+        }
+        live.swap(next);
+        if (live.empty()) break;
+    }
+    for (uint32_t id : live) {
+        r.allow = std::max(r.allow, nodes_[id].allow_end);
+        r.disallow = std::max(r.disallow, nodes_[id].disallow_end);
+    }
+    return r;
+}
+
 static std::string trim(const std::string& s) {
     size_t start = 0;
     while (start < s.size() && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
@@ -72,6 +161,12 @@ void RobotsHandler::parse(const std::string& robots_txt) {
             }
         }
     }
+
+    // Compile each group once so is_allowed is a single pass over the path
+    for (auto& [_, rule] : rules_) {
+        for (const auto& a : rule.allow) rule.matcher.add(a, true);
+        for (const auto& d : rule.disallow) rule.matcher.add(d, false);
+    }
 }
 
 const RobotsRule* RobotsHandler::get_rule_for_agent(const std::string& user_agent) const {
@@ -91,17 +186,6 @@ const RobotsRule* RobotsHandler::get_rule_for_agent(const std::string& user_agen
     return nullptr;
 }
 
-bool RobotsHandler::matches_rule(const std::string& path, const std::string& rule_path) {
-    if (rule_path.empty()) return false;
-    if (rule_path == "/") return true;
-
-    // Simple prefix match (RFC 9309 basic)
-    if (path.rfind(rule_path, 0) == 0) {
-        return true;
-    }
-    return false;
-}
-
 bool RobotsHandler::is_allowed(const std::string& url_path, const std::string& user_agent) const {
     const RobotsRule* rule = get_rule_for_agent(user_agent);
     if (!rule) {
@@ -112,30 +196,11 @@ bool RobotsHandler::is_allowed(const std::string& url_path, const std::string& u
     if (url_path.empty()) return true;
 
     // Most specific rule wins: allow overrides disallow if longer match
-    int best_allow = -1;
-    int best_disallow = -1;
-
-    for (const auto& allow : rule->allow) {
-        if (matches_rule(url_path, allow)) {
-            int len = static_cast<int>(allow.length());
-            if (len > best_allow) best_allow = len;
-        }
-    }
-
-    for (const auto& disallow : rule->disallow) {
-        if (matches_rule(url_path, disallow)) {
-            int len = static_cast<int>(disallow.length());
-            if (len > best_disallow) best_disallow = len;
-        }
-    }
-
-    if (best_allow == -1 && best_disallow == -1) {
+    RobotsMatcher::Result m = rule->matcher.match(url_path);
+    if (m.allow == -1 && m.disallow == -1) {
         return true;
     }
-    if (best_allow >= best_disallow) {
-        return true;
-    }
-    return false;
+    return m.allow >= m.disallow;
 }
 
 std::vector<std::string> RobotsHandler::get_sitemaps() const {
@@ -151,4 +216,9 @@ std::vector<std::string> RobotsHandler::get_sitemaps() const {
     return sitemaps;
 }
 
+int RobotsHandler::crawl_delay_seconds(const std::string& user_agent) const {
+    const RobotsRule* rule = get_rule_for_agent(user_agent);
+    return rule ? rule->crawl_delay_seconds : -1;
+}
+
 } // namespace docscraper::fetch
@@ -0,0 +1,262 @@
+// sitemap.cpp - Streaming Sitemap Parser Implementation
+// LLM Documentation Scraper - C++ Implementation
+
+#include "parse/sitemap.hpp"
+#include <cctype>
+#include <cstring>
+
+namespace docscraper::parse {
+
+namespace {
+
+// Sitemap URLs are limited to 2048 chars; anything far beyond that is not a sitemap field.
+constexpr size_t kMaxField = 8 * 1024;
+constexpr size_t kMaxTag = 64 * 1024;
+
+bool starts_with(const std::string& s, const char* prefix) {
+    return s.rfind(prefix, 0) == 0;
+}
+
+bool ends_with(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+std::string trim(const std::string& s) {
+    size_t start = 0;
+    while (start < s.size() && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
+    size_t end = s.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(s[end - 1]))) --end;
+    return s.substr(start, end - start);
+}
+
+void append_utf8(std::string& out, unsigned long cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x110000) {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+std::string decode_entities(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] != '&') {
+            out += s[i];
+            continue;
+        }
+        size_t semi = s.find(';', i);
+        if (semi == std::string::npos || semi - i > 10) {
+            out += s[i];
+            continue;
+        }
+        std::string ent = s.substr(i + 1, semi - i - 1);
+        if (ent == "amp") out += '&';
+        else if (ent == "lt") out += '<';
+        else if (ent == "gt") out += '>';
+        else if (ent == "quot") out += '"';
+        else if (ent == "apos") out += '\'';
+        else if (ent.size() > 1 && ent[0] == '#') {
+            try {
+                bool hex = ent[1] == 'x' || ent[1] == 'X';
+                append_utf8(out, std::stoul(ent.substr(hex ? 2 : 1), nullptr, hex ? 16 : 10));
+            } catch (...) {
+                out += s.substr(i, semi - i + 1);
+            }
+        } else {
+            out += s.substr(i, semi - i + 1);
+        }
+        i = semi;
+    }
+    return out;
+}
+
+// Element name without namespace prefix: "/ns:loc attr" -> "loc"
+std::string local_name(const std::string& tag, size_t from) {
+    size_t end = from;
+    while (end < tag.size() && !std::isspace(static_cast<unsigned char>(tag[end])) && tag[end] != '/') ++end;
+    std::string name = tag.substr(from, end - from);
+    size_t colon = name.find(':');
+    return colon == std::string::npos ? name : name.substr(colon + 1);
+}
+
+} // namespace
+
+SitemapParser::SitemapParser(Callback on_entry) : on_entry_(std::move(on_entry)) {}
+
+bool SitemapParser::feed(const char* data, size_t len) {
+    const char* p = data;
+    const char* end = data + len;
+    while (p < end && !stopped_) {
+        if (state_ == State::Text) {
+            const char* lt = static_cast<const char*>(std::memchr(p, '<', end - p));
+            const char* stop = lt ? lt : end;
+            if (capturing_) append_text(p, stop - p);
+            if (!lt) break;
+            state_ = State::Tag;
+            tag_.clear();
+            p = lt + 1;
+            continue;
+        }
+
+        const char* gt = static_cast<const char*>(std::memchr(p, '>', end - p));
+        const char* stop = gt ? gt : end;
+        tag_.append(p, stop - p);
+        if (tag_.size() > kMaxTag) {
+            // Oversized comment or CDATA: keep the opener and the last bytes needed to spot its end.
+            size_t keep = starts_with(tag_, "![CDATA[") ? 8 : 3;
+            tag_ = tag_.substr(0, keep) + tag_.substr(tag_.size() - 2);
+            if (capturing_) overflow_ = true;
+        }
+        if (!gt) break;
+        p = gt + 1;
+        if (!tag_complete()) {
+            tag_ += '>';
+            continue;
+        }
+        handle_tag();
+        state_ = State::Text;
+    }
+    return !stopped_;
+}
+
+bool SitemapParser::tag_complete() const {
+    if (starts_with(tag_, "!--")) return tag_.size() >= 5 && ends_with(tag_, "--");
+    if (starts_with(tag_, "![CDATA[")) return ends_with(tag_, "]]");
+    return true;
+}
+
+void SitemapParser::append_text(const char* data, size_t len) {
+    if (overflow_) return;
+    if (text_.size() + len > kMaxField) {
+        overflow_ = true;
+        return;
+    }
+    text_.append(data, len);
+}
+
+void SitemapParser::handle_tag() {
+    if (tag_.empty() || tag_[0] == '?') return;
+    if (tag_[0] == '!') {
+        if (capturing_ && starts_with(tag_, "![CDATA[")) {
+            // CDATA is literal; escape '&' so the entity pass at field close leaves it intact.
+            for (size_t i = 8; i + 2 < tag_.size(); ++i) {
+                if (tag_[i] == '&') append_text("&amp;", 5);
+                else append_text(&tag_[i], 1);
+            }
+        }
+        return;
+    }
+
+    bool closing = tag_[0] == '/';
+    bool self_closing = !closing && tag_.back() == '/';
+    std::string name = local_name(tag_, closing ? 1 : 0);
+
+    if (!closing) {
+        if (name == "url" || name == "sitemap") {
+            in_entry_ = true;
+            entry_ = SitemapEntry{};
+            entry_.is_sitemap = name == "sitemap";
+            overflow_ = false;
+        } else if (in_entry_ && !self_closing && (name == "loc" || name == "lastmod")) {
+            capturing_ = true;
+            field_ = name;
+            text_.clear();
+        }
+        return;
+    }
+
+    if (capturing_ && name == field_) {
+        std::string value = trim(decode_entities(text_));
+        if (field_ == "loc") entry_.loc = std::move(value);
+        else entry_.lastmod = std::move(value);
+        capturing_ = false;
+        text_.clear();
+        return;
+    }
+    if (in_entry_ && (name == "url" || name == "sitemap")) {
+        in_entry_ = false;
+        capturing_ = false;
+        if (entry_.loc.empty() || overflow_) return;
+        ++entries_;
+        if (!on_entry_(entry_)) stopped_ = true;
+    }
+}
+
+static bool read_int(const std::string& s, size_t& pos, size_t digits, int& out) {
+    if (pos + digits > s.size()) return false;
+    int v = 0;
+    for (size_t i = 0; i < digits; ++i) {
+        char c = s[pos + i];
+        if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+        v = v * 10 + (c - '0');
+    }
+    pos += digits;
+    out = v;
+    return true;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's algorithm)
+static int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+int64_t parse_w3c_datetime(const std::string& value) {
+    std::string s = trim(value);
+    size_t pos = 0;
+    int year = 0, month = 1, day = 1, hour = 0, minute = 0, second = 0;
+    if (!read_int(s, pos, 4, year)) return 0;
+    if (pos < s.size() && s[pos] == '-') {
+        ++pos;
+        if (!read_int(s, pos, 2, month)) return 0;
+        if (pos < s.size() && s[pos] == '-') {
+            ++pos;
+            if (!read_int(s, pos, 2, day)) return 0;
+        }
+    }
+    int64_t offset_s = 0;
+    if (pos < s.size() && (s[pos] == 'T' || s[pos] == 't')) {
+        ++pos;
+        if (!read_int(s, pos, 2, hour) || pos >= s.size() || s[pos++] != ':' || !read_int(s, pos, 2, minute))
+            return 0;
+        if (pos < s.size() && s[pos] == ':') {
+            ++pos;
+            if (!read_int(s, pos, 2, second)) return 0;
+            if (pos < s.size() && s[pos] == '.') {
+                ++pos;
+                while (pos < s.size() && std::isdigit(static_cast<unsigned char>(s[pos]))) ++pos;
+            }
+        }
+        if (pos < s.size() && (s[pos] == 'Z' || s[pos] == 'z')) {
+            ++pos;
+        } else if (pos < s.size() && (s[pos] == '+' || s[pos] == '-')) {
+            int sign = s[pos++] == '-' ? -1 : 1;
+            int oh = 0, om = 0;
+            if (!read_int(s, pos, 2, oh) || pos >= s.size() || s[pos++] != ':' || !read_int(s, pos, 2, om))
+                return 0;
+            offset_s = sign * (oh * 3600 + om * 60);
+        }
+    }
+    if (pos != s.size()) return 0;
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) return 0;
+    int64_t days = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    return days * 86400 + hour * 3600 + minute * 60 + second - offset_s;
+}
+
+} // namespace docscraper::parse
@@ -0,0 +1,147 @@
+#include "scrape_llm/cache_meta.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+static std::string to_lower(const std::string& s) {
+    std::string out = s;
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+int64_t unix_now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+CacheMetaStore::CacheMetaStore(std::string path)
+    : path_(std::move(path))
+{
+    std::ifstream f(path_);
+    if (!f) return;
+    try {
+        auto j = nlohmann::json::parse(f);
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            const auto& v = it.value();
+            CacheEntryMeta m;
+            m.etag = v.value("etag", "");
+            m.last_modified = v.value("last_modified", "");
+            m.cache_control = v.value("cache_control", "");
+            m.fetched_at = v.value("fetched_at", static_cast<int64_t>(0));
+            entries_[it.key()] = std::move(m);
+        }
+    } catch (...) {
+        entries_.clear();  // corrupt metadata: every cached page gets refetched
+    }
+}
+
+std::optional<CacheEntryMeta> CacheMetaStore::get(const std::string& normalized_url) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(normalized_url);
+    if (it == entries_.end()) return std::nullopt;
+    return it->second;
+}
+
+void CacheMetaStore::put(const std::string& normalized_url, CacheEntryMeta meta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[normalized_url] = std::move(meta);
+    dirty_ = true;
+}
+
+void CacheMetaStore::erase(const std::string& normalized_url) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dirty_ |= entries_.erase(normalized_url) > 0;
+}
+
+void CacheMetaStore::retain(const std::function<bool(const std::string&)>& keep) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (keep(it->first)) {
+            ++it;
+        } else {
+            it = entries_.erase(it);
+            dirty_ = true;
+        }
+    }
+}
+
+bool CacheMetaStore::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dirty_) return true;
+    nlohmann::json j = nlohmann::json::object();
+    for (const auto& [url, m] : entries_) {
+        j[url] = {
+            {"etag", m.etag},
+            {"last_modified", m.last_modified},
+            {"cache_control", m.cache_control},
+            {"fetched_at", m.fetched_at}
+        };
+    }
+    std::error_code ec;
+    fs::create_directories(fs::path(path_).parent_path(), ec);
+    std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream f(tmp);
+        if (!f) return false;
+        f << j.dump(2);
+        if (!f) return false;
+    }
+    fs::rename(tmp, path_, ec);
+    if (ec) return false;
+    dirty_ = false;
+    return true;
+}
+
+// Value of a "name=value" directive in a Cache-Control header, or -1 when absent.
+static int64_t cache_control_seconds(const std::string& cc, const std::string& name) {
+    std::string lower = to_lower(cc);
+    size_t pos = 0;
+    while ((pos = lower.find(name, pos)) != std::string::npos) {
+        bool at_start = pos == 0 || lower[pos - 1] == ',' || std::isspace(static_cast<unsigned char>(lower[pos - 1]));
+        size_t eq = pos + name.size();
+        if (at_start && eq < lower.size() && lower[eq] == '=') {
+            try {
+                return std::stoll(lower.substr(eq + 1));
+            } catch (...) {
+                return -1;
+            }
+        }
+        pos = eq;
+    }
+    return -1;
+}
+
+static bool has_directive(const std::string& cc, const std::string& name) {
+    std::string lower = to_lower(cc);
+    size_t pos = 0;
+    while ((pos = lower.find(name, pos)) != std::string::npos) {
+        size_t end = pos + name.size();
+        bool at_start = pos == 0 || lower[pos - 1] == ',' || std::isspace(static_cast<unsigned char>(lower[pos - 1]));
+        bool at_end = end == lower.size() || lower[end] == ',' || std::isspace(static_cast<unsigned char>(lower[end]));
+        if (at_start && at_end) return true;
+        pos = end;
+    }
+    return false;
+}
+
+bool cache_entry_fresh(const CacheEntryMeta& meta, int64_t now, int64_t default_max_age_s) {
+    if (has_directive(meta.cache_control, "no-cache")) return false;
+    int64_t max_age = cache_control_seconds(meta.cache_control, "s-maxage");
+    if (max_age < 0) max_age = cache_control_seconds(meta.cache_control, "max-age");
+    if (max_age < 0) max_age = default_max_age_s;
+    return now - meta.fetched_at < max_age;
+}
+
+bool cache_control_no_store(const std::string& cache_control) {
+    return has_directive(cache_control, "no-store");
+}
+
+} // namespace scrapellm
@@ -0,0 +1,276 @@
+#include "scrape_llm/checkpoint.hpp"
+#include "scrape_llm/report_generator.hpp"
+#include <spdlog/spdlog.h>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kFormatVersion = 1;
+
+// Let write fill a temporary file, then rename it over path, so readers see the old or the new file.
+template <typename Fn>
+bool write_stream_atomic(const std::string& path, Fn write) {
+    std::string tmp = path + ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!write(f) || !f.flush()) {
+            f.close();
+            fs::remove(tmp, ec);
+            return false;
+        }
+    }
+    fs::rename(tmp, path, ec);
+    if (!ec) return true;
+    fs::remove(tmp, ec);
+    return false;
+}
+
+bool write_file_atomic(const std::string& path, const std::string& data) {
+    return write_stream_atomic(path, [&data](std::ofstream& f) {
+        f.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(f);
+    });
+}
+
+bool read_file(const std::string& path, std::string& out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    out.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Calls fn for each line of a JSON-lines file that parses; stops silently at a torn line.
+template <typename Fn>
+void for_each_json_line(const std::string& path, Fn fn) {
+    std::ifstream f(path);
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty()) continue;
+        json j = json::parse(line, nullptr, false);
+        if (j.is_discarded() || !j.is_object()) break;
+        fn(j);
+    }
+}
+
+} // namespace
+
+Checkpoint::Checkpoint(const RunConfig& config)
+    : dir_(config.out_dir + "/checkpoint")
+    , url_(config.url)
+    , schema_(config.schema)
+{}
+
+std::string Checkpoint::frontier_path(uint64_t gen) const {
+    return path("frontier-" + std::to_string(gen) + ".jsonl");
+}
+
+std::string Checkpoint::segment_name(uint64_t gen, size_t index) const {
+    return "frontier-" + std::to_string(gen) + "-" + std::to_string(index) + ".seg";
+}
+
+std::string Checkpoint::seen_path(uint64_t gen) const {
+    return path("seen-" + std::to_string(gen) + ".bin");
+}
+
+void Checkpoint::reset() {
+    relevance_log_.close();
+    parsed_log_.close();
+    relevance_.clear();
+    parsed_.clear();
+    generation_ = 0;
+    std::error_code ec;
+    fs::remove_all(dir_, ec);
+}
+
+void Checkpoint::remove_generations_except(uint64_t gen) const {
+    std::string keep_frontier = fs::path(frontier_path(gen)).filename().string();
+    std::string keep_segments = "frontier-" + std::to_string(gen) + "-";
+    std::string keep_seen = fs::path(seen_path(gen)).filename().string();
+    std::error_code ec;
+    for (fs::directory_iterator it(dir_, ec), end; !ec && it != end; it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        bool generation_file = name.rfind("frontier-", 0) == 0 || name.rfind("seen-", 0) == 0;
+        bool kept = name == keep_frontier || name == keep_seen ||
+                    (name.rfind(keep_segments, 0) == 0 && fs::path(name).extension() == ".seg");
+        if (generation_file && !kept) {
+            std::error_code rm_ec;
+            fs::remove(it->path(), rm_ec);
+        }
+    }
+}
+
+bool Checkpoint::save_crawl(const CrawlState& state, const CrawlFrontier& frontier,
+                            const std::vector<CrawlFrontier::Entry>& in_flight,
+                            const docscraper::utils::UrlSeenSet& seen) {
+    std::error_code ec;
+    fs::create_directories(dir_, ec);
+    uint64_t gen = generation_ + 1;
+
+    // The frontier is streamed to its file, in-flight URLs first: they were popped before anything
+    // still queued. Spilled segments are hard-linked (copied where that fails) and stand in their
+    // place as one line each, so the crawl lock is not held while they are read and re-encoded.
+    size_t pending = 0;
+    size_t segments = 0;
+    bool frontier_ok = write_stream_atomic(frontier_path(gen), [&](std::ofstream& f) {
+        auto add = [&](const CrawlFrontier::Entry& e) {
+            json line = {{"url", e.url}, {"depth", e.depth}, {"lastmod", e.lastmod}, {"score", e.score},
+                         {"pagination", e.pagination}};
+            f << line.dump() << '\n';
+            ++pending;
+        };
+        auto link = [&](const std::string& segment, size_t count) {
+            std::string name = segment_name(gen, segments++);
+            std::error_code link_ec;
+            fs::remove(path(name), link_ec);  // left by a failed save of this generation
+            fs::create_hard_link(segment, path(name), link_ec);
+            if (link_ec && !fs::copy_file(segment, path(name), link_ec)) return false;
+            f << json{{"segment", name}, {"count", count}}.dump() << '\n';
+            pending += count;
+            return static_cast<bool>(f);
+        };
+        for (const auto& e : in_flight) add(e);
+        return frontier.for_each(add, link) && f;
+    });
+
+    // Raw fingerprints in native byte order; a checkpoint is resumed on the machine that wrote it.
+    std::vector<uint64_t> fps = seen.fingerprints();
+    std::string seen_data(reinterpret_cast<const char*>(fps.data()), fps.size() * sizeof(uint64_t));
+
+    json crawled = json::array();
+    for (const auto& p : state.crawled)
+        crawled.push_back({{"url", p.url}, {"normalized_url", p.normalized_url}, {"final_url", p.final_url},
+                           {"depth", p.depth}, {"simhash", p.simhash}});
+    json j = {{"version", kFormatVersion},
+              {"url", url_},
+              {"schema", schema_},
+              {"generation", gen},
+              {"done", state.done},
+              {"frontier_entries", pending},
+              {"seen_entries", fps.size()},
+              {"report", report_to_json(state.report)},
+              {"crawled", std::move(crawled)}};
+
+    if (!frontier_ok || !write_file_atomic(seen_path(gen), seen_data) ||
+        !write_file_atomic(path("state.json"), j.dump())) {
+        spdlog::warn("Checkpoint: could not write to {}", dir_);
+        return false;
+    }
+    generation_ = gen;
+    remove_generations_except(gen);
+    return true;
+}
+
+bool Checkpoint::load(CrawlState& state, CrawlFrontier& frontier, docscraper::utils::UrlSeenSet& seen) {
+    std::string data;
+    if (!read_file(path("state.json"), data)) return false;
+    json j = json::parse(data, nullptr, false);
+    if (j.is_discarded() || !j.is_object() || j.value("version", 0) != kFormatVersion) {
+        spdlog::warn("Checkpoint: unreadable {}", path("state.json"));
+        return false;
+    }
+    if (j.value("url", "") != url_ || j.value("schema", "") != schema_) {
+        spdlog::warn("Checkpoint in {} is for a different --url or --schema", dir_);
+        return false;
+    }
+    uint64_t gen = j.value("generation", static_cast<uint64_t>(0));
+
+    std::string seen_data;
+    if (!read_file(seen_path(gen), seen_data) || seen_data.size() % sizeof(uint64_t) != 0 ||
+        seen_data.size() / sizeof(uint64_t) != j.value("seen_entries", static_cast<size_t>(0))) {
+        spdlog::warn("Checkpoint: seen-set for generation {} is missing or truncated", gen);
+        return false;
+    }
+    // Entries go straight into the frontier, one line or linked segment at a time, so it can
+    // spill as usual instead of the whole saved frontier being held in memory first.
+    size_t pushed = 0;
+    bool segments_ok = true;
+    for_each_json_line(frontier_path(gen), [&](const json& line) {
+        if (line.contains("segment")) {
+            std::string name = line.value("segment", "");
+            std::deque<CrawlFrontier::Entry> loaded;
+            segments_ok = segments_ok && !name.empty() && fs::path(name).filename() == name &&
+                          CrawlFrontier::read_segment(path(name), line.value("count", static_cast<size_t>(0)), loaded);
+            pushed += loaded.size();
+            for (auto& e : loaded) frontier.push(std::move(e));
+            return;
+        }
+        frontier.push({line.value("url", ""), line.value("depth", 0), line.value("lastmod", static_cast<int64_t>(0)),
+                       line.value("score", 0.0), line.value("pagination", 0)});
+        ++pushed;
+    });
+    if (!segments_ok || pushed != j.value("frontier_entries", static_cast<size_t>(0))) {
+        spdlog::warn("Checkpoint: frontier for generation {} is missing or truncated", gen);
+        frontier.clear();
+        return false;
+    }
+
+    state = CrawlState{};
+    state.done = j.value("done", false);
+    state.report = report_from_json(j.value("report", json::object()));
+    if (j.contains("crawled") && j["crawled"].is_array()) {
+        for (const auto& p : j["crawled"])
+            state.crawled.push_back({p.value("url", ""), p.value("normalized_url", ""), p.value("final_url", ""),
+                                     p.value("depth", 0), p.value("simhash", static_cast<uint64_t>(0))});
+    }
+    for (size_t off = 0; off < seen_data.size(); off += sizeof(uint64_t)) {
+        uint64_t fp = 0;
+        std::memcpy(&fp, seen_data.data() + off, sizeof(fp));
+        seen.insert_fingerprint(fp);
+    }
+    generation_ = gen;
+    load_memos();
+    return true;
+}
+
+void Checkpoint::load_memos() {
+    relevance_.clear();
+    parsed_.clear();
+    for_each_json_line(path("relevance.jsonl"), [&](const json& line) {
+        relevance_[line.value("url", "")] = RelevanceDecision{line.value("keep", false), line.value("reason", "")};
+    });
+    for_each_json_line(path("parsed.jsonl"), [&](const json& line) {
+        parsed_[line.value("url", "")] = parsed_page_from_json(line);
+    });
+}
+
+const RelevanceDecision* Checkpoint::relevance(const std::string& url) const {
+    auto it = relevance_.find(url);
+    return it == relevance_.end() ? nullptr : &it->second;
+}
+
+const ParsedPage* Checkpoint::parsed(const std::string& url) const {
+    auto it = parsed_.find(url);
+    return it == parsed_.end() ? nullptr : &it->second;
+}
+
+// Each line is flushed as written, so a kill loses at most the result being written.
+void Checkpoint::append(std::ofstream& log, const std::string& name, const json& line) {
+    if (!log.is_open()) {
+        std::error_code ec;
+        fs::create_directories(dir_, ec);
+        log.open(path(name), std::ios::app);
+    }
+    log << line.dump() << '\n';
+    log.flush();
+}
+
+void Checkpoint::record_relevance(const std::string& url, const RelevanceDecision& decision) {
+    relevance_[url] = decision;
+    append(relevance_log_, "relevance.jsonl", {{"url", url}, {"keep", decision.keep}, {"reason", decision.reason}});
+}
+
+void Checkpoint::record_parsed(const std::string& url, const ParsedPage& page) {
+    parsed_[url] = page;
+    json line = parsed_page_to_json(page);
+    line["url"] = url;
+    append(parsed_log_, "parsed.jsonl", line);
+}
+
+} // namespace scrapellm
@@ -1,5 +1,6 @@
 #include "scrape_llm/cli_config.hpp"
 #include <cxxopts.hpp>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -20,13 +21,38 @@ bool parse_cli(int argc, char** argv, RunConfig& out_config) {
         ("max-pages", "Max pages to crawl", cxxopts::value<int>()->default_value("30"))
         ("max-depth", "Max BFS depth", cxxopts::value<int>()->default_value("2"))
         ("keep-pages", "Max pages to parse with LLM", cxxopts::value<int>()->default_value("10"))
+        ("near-dup-distance", "Pages whose text SimHash differs in at most this many bits are sent to the LLM once (-1 = off)", cxxopts::value<int>()->default_value("3"))
+        ("use-canonical", "Treat pages whose <link rel=\"canonical\"> names the same URL as one page", cxxopts::value<bool>()->default_value("true"))
+        ("crawl-order", "Frontier order: best-first (links scored against the schema), bfs", cxxopts::value<std::string>()->default_value("best-first"))
+        ("link-model", "Learn from relevance decisions which links lead to kept pages, and fetch those first in later runs (state carried across runs in cache/link_model.json)", cxxopts::value<bool>()->default_value("false"))
+        ("skip-predicted", "Do not fetch links the link model predicts SKIP with at least this confidence, above 0.5 and up to 1 (0 = off)", cxxopts::value<double>()->default_value("0"))
+        ("link-graph", "Record links between crawled pages: queued URLs move up as more pages link to them, and PageRank orders kept pages", cxxopts::value<bool>()->default_value("true"))
+        ("export-graph", "Write the link graph to out/graph (nodes.tsv, edges.tsv)")
+        ("max-pagination", "List schemas: next pages followed along one listing's pagination, regardless of --max-depth (0 = off)", cxxopts::value<int>()->default_value("100"))
+        ("max-per-template", "Pages fetched per URL template, e.g. /product/{num} (0 = no cap)", cxxopts::value<int>()->default_value("0"))
+        ("template-probe", "After this many pages of a URL template without one matching the schema, fetch only 1 in 10 more (0 = off)", cxxopts::value<int>()->default_value("0"))
+        ("frontier-memory", "Frontier URLs kept in memory; more are spilled to disk (0 = no limit)", cxxopts::value<int64_t>()->default_value("200000"))
         ("rate-limit", "Requests per second", cxxopts::value<double>()->default_value("1.0"))
+        ("adaptive-rate", "Adapt each host's rate to its latency and 429/503 responses")
+        ("max-rate", "Per-host rate ceiling with --adaptive-rate (requests per second)", cxxopts::value<double>()->default_value("10.0"))
+        ("crawl-workers", "Parallel fetch workers", cxxopts::value<int>()->default_value("1"))
+        ("connections-per-host", "Keep-alive connections pooled per host", cxxopts::value<int>()->default_value("2"))
+        ("fetch-backend", "Crawl fetch backend: httplib, curl-multi", cxxopts::value<std::string>()->default_value("httplib"))
+        ("max-in-flight", "Concurrent transfers for curl-multi backend", cxxopts::value<int>()->default_value("64"))
+        ("cache-max-mb", "Page cache size budget in MB (0 = unbounded)", cxxopts::value<int64_t>()->default_value("1024"))
+        ("cache-max-age", "Seconds a cached page without Cache-Control max-age is served without revalidation", cxxopts::value<int64_t>()->default_value("86400"))
+        ("max-page-bytes", "Abort pages larger than this many bytes", cxxopts::value<int64_t>()->default_value("10485760"))
+        ("seed-from-sitemaps", "Seed the crawl frontier from the site's sitemaps")
         ("respect-robots", "Honor robots.txt", cxxopts::value<bool>()->default_value("true"))
+        ("robots-ttl", "Seconds a cached robots.txt is reused before refetching", cxxopts::value<int64_t>()->default_value("86400"))
         ("allow-private-network", "Allow localhost/private IPs", cxxopts::value<bool>()->default_value("false"))
         ("model", "LLM model name", cxxopts::value<std::string>()->default_value("gpt-4.1-mini"))
         ("base-url", "LLM API base URL", cxxopts::value<std::string>()->default_value(""))
         ("csv", "Also emit CSV if flat")
         ("dry-run", "Crawl and select only, no parsing")
+        ("incremental", "Reuse relevance decisions and records from the last run for pages whose content is unchanged")
+        ("resume", "Continue from the checkpoint in --out left by an interrupted run")
+        ("checkpoint-interval", "Seconds between crawl checkpoints (0 = only when the crawl ends)", cxxopts::value<int64_t>()->default_value("60"))
         ("h,help", "Print help")
         ("version", "Print version");
 
@@ -55,18 +81,61 @@ bool parse_cli(int argc, char** argv, RunConfig& out_config) {
         out_config.max_pages = result["max-pages"].as<int>();
         out_config.max_depth = result["max-depth"].as<int>();
         out_config.keep_pages = result["keep-pages"].as<int>();
+        out_config.near_dup_distance = std::clamp(result["near-dup-distance"].as<int>(), -1, 32);
+        out_config.use_canonical = result["use-canonical"].as<bool>();
+        out_config.crawl_order = result["crawl-order"].as<std::string>();
+        out_config.link_model = result["link-model"].as<bool>();
+        out_config.skip_predicted = std::clamp(result["skip-predicted"].as<double>(), 0.0, 1.0);
+        out_config.export_graph = result.count("export-graph") > 0;
+        out_config.link_graph = result["link-graph"].as<bool>() || out_config.export_graph;
+        out_config.max_pagination = std::max(0, result["max-pagination"].as<int>());
+        out_config.max_per_template = std::max(0, result["max-per-template"].as<int>());
+        out_config.template_probe = std::max(0, result["template-probe"].as<int>());
+        out_config.frontier_memory = result["frontier-memory"].as<int64_t>();
         out_config.rate_limit = result["rate-limit"].as<double>();
+        out_config.adaptive_rate = result.count("adaptive-rate") > 0;
+        out_config.max_rate = result["max-rate"].as<double>();
+        out_config.crawl_workers = result["crawl-workers"].as<int>();
+        out_config.connections_per_host = result["connections-per-host"].as<int>();
+        out_config.fetch_backend = result["fetch-backend"].as<std::string>();
+        out_config.max_in_flight = result["max-in-flight"].as<int>();
+        out_config.cache_max_age_s = result["cache-max-age"].as<int64_t>();
+        out_config.cache_max_mb = result["cache-max-mb"].as<int64_t>();
+        out_config.max_page_bytes = result["max-page-bytes"].as<int64_t>();
+        out_config.seed_from_sitemaps = result.count("seed-from-sitemaps") > 0;
         out_config.respect_robots = result["respect-robots"].as<bool>();
+        out_config.robots_ttl_s = result["robots-ttl"].as<int64_t>();
         out_config.allow_private_network = result["allow-private-network"].as<bool>();
         out_config.model = result["model"].as<std::string>();
         out_config.base_url = result["base-url"].as<std::string>();
         out_config.emit_csv = result.count("csv") > 0;
         out_config.dry_run = result.count("dry-run") > 0;
+        out_config.incremental = result.count("incremental") > 0;
+        out_config.resume = result.count("resume") > 0;
+        out_config.checkpoint_interval_s = result["checkpoint-interval"].as<int64_t>();
 
         if (out_config.max_pages < 1) out_config.max_pages = 30;
         if (out_config.max_depth < 0) out_config.max_depth = 2;
         if (out_config.keep_pages < 1) out_config.keep_pages = 10;
         if (out_config.rate_limit <= 0.0) out_config.rate_limit = 1.0;
+        if (out_config.max_rate < out_config.rate_limit) out_config.max_rate = out_config.rate_limit;
+        if (out_config.crawl_workers < 1) out_config.crawl_workers = 1;
+        if (out_config.connections_per_host < 1) out_config.connections_per_host = 2;
+        if (out_config.fetch_backend != "httplib" && out_config.fetch_backend != "curl-multi") {
+            std::cerr << "Error: --fetch-backend must be httplib or curl-multi.\n";
+            return false;
+        }
+        if (out_config.crawl_order != "best-first" && out_config.crawl_order != "bfs") {
+            std::cerr << "Error: --crawl-order must be best-first or bfs.\n";
+            return false;
+        }
+        if (out_config.frontier_memory < 0) out_config.frontier_memory = 0;
+        if (out_config.checkpoint_interval_s < 0) out_config.checkpoint_interval_s = 0;
+        if (out_config.max_in_flight < 1) out_config.max_in_flight = 64;
+        if (out_config.cache_max_age_s < 0) out_config.cache_max_age_s = 0;
+        if (out_config.cache_max_mb < 0) out_config.cache_max_mb = 0;
+        if (out_config.robots_ttl_s < 0) out_config.robots_ttl_s = 0;
+        if (out_config.max_page_bytes < 1) out_config.max_page_bytes = 10 << 20;
 
         return true;
     } catch (const std::exception& e) {
@@ -0,0 +1,88 @@
+#include "scrape_llm/connection_pool.hpp"
+#include <httplib.h>
+#include <algorithm>
+
+namespace scrapellm {
+
+ConnectionPool::Lease::Lease(ConnectionPool* pool, std::string origin, std::unique_ptr<httplib::Client> client)
+    : pool_(pool)
+    , origin_(std::move(origin))
+    , client_(std::move(client))
+{}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_)
+    , origin_(std::move(other.origin_))
+    , client_(std::move(other.client_))
+    , discard_(other.discard_)
+{
+    other.pool_ = nullptr;
+}
+
+ConnectionPool::Lease::~Lease() {
+    if (pool_ && client_) pool_->release(origin_, std::move(client_), discard_);
+}
+
+ConnectionPool::ConnectionPool(Options options)
+    : options_(options)
+{
+    options_.max_per_host = std::max(1, options_.max_per_host);
+}
+
+ConnectionPool::~ConnectionPool() = default;
+
+ConnectionPool::Lease ConnectionPool::acquire(const std::string& origin) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    evict_idle_locked(std::chrono::steady_clock::now());
+    cv_.wait(lock, [&] {
+        const HostSlot& s = hosts_[origin];
+        return !s.idle.empty() || s.open < options_.max_per_host;
+    });
+
+    HostSlot& slot = hosts_[origin];
+    if (!slot.idle.empty()) {
+        auto client = std::move(slot.idle.back().client);
+        slot.idle.pop_back();
+        return Lease(this, origin, std::move(client));
+    }
+
+    slot.open++;
+    lock.unlock();
+    auto client = std::make_unique<httplib::Client>(origin);
+    client->set_keep_alive(true);
+    return Lease(this, origin, std::move(client));
+}
+
+void ConnectionPool::release(const std::string& origin, std::unique_ptr<httplib::Client> client, bool discard) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        HostSlot& slot = hosts_[origin];
+        if (discard) {
+            slot.open--;
+        } else {
+            slot.idle.push_back({std::move(client), std::chrono::steady_clock::now()});
+        }
+    }
+    cv_.notify_all();
+    // A discarded client is destroyed here, outside the lock, closing its socket.
+}
+
+void ConnectionPool::evict_idle() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict_idle_locked(std::chrono::steady_clock::now());
+}
+
+void ConnectionPool::evict_idle_locked(std::chrono::steady_clock::time_point now) {
+    for (auto it = hosts_.begin(); it != hosts_.end();) {
+        auto& idle = it->second.idle;
+        auto stale_end = std::find_if(idle.begin(), idle.end(), [&](const IdleClient& c) {
+            return now - c.last_used < options_.idle_timeout;
+        });
+        it->second.open -= static_cast<int>(stale_end - idle.begin());
+        idle.erase(idle.begin(), stale_end);
+        if (it->second.open == 0) it = hosts_.erase(it);
+        else ++it;
+    }
+}
+
+} // namespace scrapellm
@@ -90,4 +90,158 @@ std::vector<std::string> extract_links_absolute(
     return out;
 }
 
+static std::string collapse_ws(const std::string& s, size_t max_chars) {
+    std::string out;
+    bool space = false;
+    for (char c : s) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            space = !out.empty();
+            continue;
+        }
+        if (space) out += ' ';
+        space = false;
+        out += c;
+        if (out.size() >= max_chars) break;
+    }
+    return out;
+}
+
+static bool is_heading(GumboTag tag) {
+    return tag == GUMBO_TAG_H1 || tag == GUMBO_TAG_H2 || tag == GUMBO_TAG_H3 ||
+           tag == GUMBO_TAG_H4 || tag == GUMBO_TAG_H5 || tag == GUMBO_TAG_H6;
+}
+
+static bool has_rel_token(const std::string& rel, const std::string& token) {
+    std::istringstream tokens(rel);
+    std::string t;
+    while (tokens >> t) {
+        std::transform(t.begin(), t.end(), t.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (t == token) return true;
+    }
+    return false;
+}
+
+// Document-order walk; heading holds the text of the last heading seen so far.
+static void collect_links(GumboNode* node, const std::string& base_url, std::string& heading,
+                          std::vector<LinkContext>& out) {
+    if (node->type != GUMBO_NODE_ELEMENT) return;
+    GumboTag tag = node->v.element.tag;
+    if (tag == GUMBO_TAG_SCRIPT || tag == GUMBO_TAG_STYLE || tag == GUMBO_TAG_NOSCRIPT) return;
+    docscraper::parse::HTMLElement el(node);
+    if (is_heading(tag)) heading = collapse_ws(el.text(), 200);
+    if (tag == GUMBO_TAG_LINK) {
+        // <link rel="next"> in the head names the next page of a paginated listing.
+        std::string rel = el.attr("rel");
+        std::string href = el.attr("href");
+        if (href.empty() || !has_rel_token(rel, "next")) return;
+        auto resolved = docscraper::parse::URLNormalizer::resolve(base_url, href);
+        if (!resolved || !docscraper::parse::URLNormalizer::is_valid_http_url(*resolved)) return;
+        LinkContext link;
+        link.url = std::move(*resolved);
+        link.rel = std::move(rel);
+        link.heading = heading;
+        out.push_back(std::move(link));
+        return;
+    }
+    if (tag == GUMBO_TAG_A) {
+        std::string href = el.attr("href");
+        if (href.empty()) return;
+        auto resolved = docscraper::parse::URLNormalizer::resolve(base_url, href);
+        if (!resolved || !docscraper::parse::URLNormalizer::is_valid_http_url(*resolved)) return;
+        LinkContext link;
+        link.url = std::move(*resolved);
+        link.anchor = collapse_ws(el.text(), 200);
+        if (link.anchor.empty()) {
+            auto img = el.select_first("img");
+            link.anchor = collapse_ws(img ? img->attr("alt") : el.attr("title"), 200);
+        }
+        link.heading = heading;
+        link.rel = el.attr("rel");
+        out.push_back(std::move(link));
+        return;
+    }
+    GumboVector* children = &node->v.element.children;
+    for (size_t i = 0; i < children->length; ++i)
+        collect_links(static_cast<GumboNode*>(children->data[i]), base_url, heading, out);
+}
+
+std::vector<LinkContext> extract_links_with_context(
+    const docscraper::parse::HTMLDocument& doc,
+    const std::string& base_url
+) {
+    std::vector<LinkContext> out;
+    std::string heading;
+    collect_links(doc.root().node(), base_url, heading, out);
+    return out;
+}
+
+// Attributes of one tag's source ("<link rel=canonical href='...'>"); names lowercased.
+static std::vector<std::pair<std::string, std::string>> tag_attributes(const std::string& tag) {
+    std::vector<std::pair<std::string, std::string>> attrs;
+    size_t i = tag.find_first_of(" \t\r\n/");
+    while (i != std::string::npos && i < tag.size()) {
+        while (i < tag.size() && (std::isspace(static_cast<unsigned char>(tag[i])) || tag[i] == '/')) ++i;
+        size_t name_start = i;
+        while (i < tag.size() && tag[i] != '=' && tag[i] != '>' && !std::isspace(static_cast<unsigned char>(tag[i]))) ++i;
+        if (i == name_start) break;
+        std::string name = tag.substr(name_start, i - name_start);
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        while (i < tag.size() && std::isspace(static_cast<unsigned char>(tag[i]))) ++i;
+        std::string value;
+        if (i < tag.size() && tag[i] == '=') {
+            ++i;
+            while (i < tag.size() && std::isspace(static_cast<unsigned char>(tag[i]))) ++i;
+            if (i < tag.size() && (tag[i] == '"' || tag[i] == '\'')) {
+                size_t close = tag.find(tag[i], i + 1);
+                if (close == std::string::npos) close = tag.size();
+                value = tag.substr(i + 1, close - i - 1);
+                i = close + 1;
+            } else {
+                size_t end = i;
+                while (end < tag.size() && tag[end] != '>' && !std::isspace(static_cast<unsigned char>(tag[end]))) ++end;
+                value = tag.substr(i, end - i);
+                i = end;
+            }
+        }
+        attrs.emplace_back(std::move(name), std::move(value));
+    }
+    return attrs;
+}
+
+std::string canonical_link(const std::string& html, const std::string& base_url) {
+    // The head is expected near the top; the scan stops at <body> or 256 KB.
+    constexpr size_t kMaxScan = 256 * 1024;
+    std::string lower = html.substr(0, kMaxScan);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    size_t head_end = std::min(lower.find("</head"), lower.find("<body"));
+    if (head_end != std::string::npos) lower.resize(head_end);
+
+    for (size_t pos = lower.find("<link"); pos != std::string::npos; pos = lower.find("<link", pos + 5)) {
+        size_t end = lower.find('>', pos);
+        if (end == std::string::npos) break;
+        std::string rel, href;
+        bool has_href = false;
+        for (auto& [name, value] : tag_attributes(html.substr(pos, end - pos))) {
+            if (name == "rel") rel = value;
+            else if (name == "href") { href = std::move(value); has_href = true; }
+        }
+        if (!has_rel_token(rel, "canonical") || !has_href) continue;
+
+        for (size_t amp = href.find("&amp;"); amp != std::string::npos; amp = href.find("&amp;", amp + 1))
+            href.replace(amp, 5, "&");
+        href = trim_ws(href);
+        // A scheme other than http(s) ("javascript:", "mailto:") would resolve as a relative path.
+        size_t colon = href.find(':');
+        if (href.empty() || (colon != std::string::npos && colon < href.find_first_of("/?#") &&
+                             !docscraper::parse::URLNormalizer::is_absolute(href)))
+            return "";
+        auto resolved = docscraper::parse::URLNormalizer::resolve(base_url, href);
+        if (!resolved || !docscraper::parse::URLNormalizer::is_valid_http_url(*resolved)) return "";
+        return docscraper::parse::URLNormalizer::normalize(*resolved, false);
+    }
+    return "";
+}
+
 } // namespace scrapellm
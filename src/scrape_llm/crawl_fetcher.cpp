@@ -1,84 +1,283 @@
 #include "scrape_llm/crawl_fetcher.hpp"
 #include "scrape_llm/ssrf_guard.hpp"
 #include "parse/normalizer.hpp"
-#include "utils/hash.hpp"
 #include <httplib.h>
+#include <algorithm>
 #include <chrono>
-#include <fstream>
-#include <filesystem>
 
 namespace scrapellm {
 
-namespace fs = std::filesystem;
+static std::string origin_of(const docscraper::parse::URLComponents& parsed) {
+    std::string origin = parsed.scheme + "://" + parsed.host;
+    if (parsed.port > 0 && !parsed.is_default_port())
+        origin += ":" + std::to_string(parsed.port);
+    return origin;
+}
 
 CrawlFetcher::CrawlFetcher(const RunConfig& config)
     : config_(config)
     , rate_limiter_(config.rate_limit_delay_ms())
+    , pool_(ConnectionPool::Options{config.connections_per_host, std::chrono::seconds(30)})
+    , robots_cache_(RobotsCache::Options{config.out_dir + "/cache/robots.json", config.robots_ttl_s, 300})
+    , dns_(DnsCache::Options{})
+    , page_store_(PageStore::Options{config.out_dir + "/cache/pages",
+                                     static_cast<uint64_t>(config.cache_max_mb) << 20,
+                                     64ull << 20})
+    , cache_meta_(config.out_dir + "/cache/meta.json")
+    , redirects_(config.out_dir + "/cache/redirects.json")
     , user_agent_("scrape-llm/1.0 (+https://github.com/GraphWeaver)")
 {
-    cache_dir_ = config.out_dir + "/cache/pages";
+    if (config.adaptive_rate) {
+        docscraper::fetch::AdaptiveRateOptions adaptive;
+        adaptive.min_delay = std::chrono::milliseconds(static_cast<int64_t>(1000.0 / config.max_rate));
+        rate_limiter_.enable_adaptive(adaptive);
+    }
+}
+
+CrawlFetcher::~CrawlFetcher() {
+    std::vector<std::future<void>> prefetch;
+    {
+        std::lock_guard<std::mutex> lock(robots_fetch_mutex_);
+        prefetch.swap(robots_prefetch_);
+    }
+    for (auto& f : prefetch) f.wait();
+    flush_cache();
+}
+
+void CrawlFetcher::flush_cache() {
+    page_store_.flush();
+    // Metadata of pages the store has evicted would only trigger conditional requests for
+    // copies that are gone.
+    cache_meta_.retain([this](const std::string& normalized_url) { return in_cache(normalized_url); });
+    cache_meta_.save();
+    robots_cache_.save();
+    redirects_.save();
 }
 
-std::string CrawlFetcher::cache_path_for(const std::string& normalized_url) const {
-    return cache_dir_ + "/" + docscraper::utils::sha256_hash(normalized_url) + ".html";
+std::optional<std::string> CrawlFetcher::cached_page(const std::string& normalized_url) const {
+    return page_store_.get(normalized_url);
+}
+
+bool CrawlFetcher::in_cache(const std::string& normalized_url) const {
+    return page_store_.contains(normalized_url);
 }
 
 bool CrawlFetcher::load_from_cache(const std::string& normalized_url, std::string& out_html) const {
-    std::string path = cache_path_for(normalized_url);
-    std::ifstream f(path);
-    if (!f) return false;
-    out_html.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    auto html = page_store_.get(normalized_url);
+    if (!html) return false;
+    out_html = std::move(*html);
     return true;
 }
 
 void CrawlFetcher::save_to_cache(const std::string& normalized_url, const std::string& html) {
-    fs::create_directories(cache_dir_);
-    std::string path = cache_path_for(normalized_url);
-    std::ofstream f(path);
-    if (f) f << html;
+    page_store_.put(normalized_url, html);
+}
+
+// Resolve host once (cached) and return the addresses to connect to. Every address is checked, so
+// a name that mixes public and private records is refused; connecting to the checked addresses
+// rather than resolving again closes the DNS-rebinding window. IPv4 goes first because httplib
+// only takes one address and has no fallback, and IPv6 reachability is the less certain of the two.
+bool CrawlFetcher::pin_addresses(const std::string& host, std::vector<std::string>& addresses, std::string& error) {
+    auto resolved = dns_.resolve(host);
+    if (!resolved.ok()) {
+        error = "DNS lookup failed: " + resolved.error;
+        return false;
+    }
+    if (!config_.allow_private_network) {
+        std::string blocked = first_private_address(resolved.addresses);
+        if (!blocked.empty()) {
+            error = "SSRF blocked: " + host + " resolves to " + blocked;
+            return false;
+        }
+    }
+    addresses = std::move(resolved.addresses);
+    std::stable_partition(addresses.begin(), addresses.end(),
+                          [](const std::string& a) { return a.find(':') == std::string::npos; });
+    return true;
+}
+
+// httplib connects to the pinned address but still sends the host name for Host and SNI.
+static void pin_client(ConnectionPool::Lease& lease, const std::string& host, const std::vector<std::string>& addresses) {
+    lease->set_hostname_addr_map({{host, addresses.front()}});
+}
+
+// Each origin's robots.txt is downloaded once: concurrent callers for the same origin wait on the
+// one download, while other origins load in parallel (the wait includes that host's rate limit).
+RobotsCache::EntryPtr CrawlFetcher::robots_entry(const docscraper::parse::URLComponents& parsed) {
+    std::string origin = origin_of(parsed);
+    auto cached = robots_cache_.get(origin, unix_now());
+    if (!cached) {
+        std::promise<RobotsCache::EntryPtr> promise;
+        std::shared_future<RobotsCache::EntryPtr> loading;
+        {
+            std::lock_guard<std::mutex> lock(robots_fetch_mutex_);
+            auto it = robots_loading_.find(origin);
+            if (it != robots_loading_.end()) {
+                loading = it->second;
+            } else {
+                cached = robots_cache_.get(origin, unix_now());  // another worker may have just fetched it
+                if (!cached) robots_loading_.emplace(origin, promise.get_future().share());
+            }
+        }
+        if (loading.valid()) {
+            cached = loading.get();
+        } else if (!cached) {
+            cached = download_robots(origin);
+            promise.set_value(cached);
+            std::lock_guard<std::mutex> lock(robots_fetch_mutex_);
+            robots_loading_.erase(origin);
+        }
+    }
+    apply_crawl_delay(origin, parsed.host, *cached);
+    return cached;
+}
+
+// Redirects are followed one hop at a time, each through resource_target; the rules found still
+// apply to origin. A hop that is refused counts as unreachable, too many hops as no robots.txt.
+RobotsCache::EntryPtr CrawlFetcher::download_robots(const std::string& origin) {
+    int status = 0;
+    std::string body;
+    std::string url = origin + "/robots.txt";
+    std::string error;
+    FetchTarget target;
+    for (int hops = 0;; ++hops) {
+        if (!resource_target(url, target, error)) {
+            status = 0;
+            break;
+        }
+        rate_limiter_.wait_for_host(target.host);
+        auto lease = pool_.acquire(target.origin);
+        pin_client(lease, target.host, target.addresses);
+        lease->set_follow_location(false);
+        lease->set_decompress(true);
+        lease->set_connection_timeout(10);
+        lease->set_read_timeout(10);
+        auto res = lease->Get(target.path.c_str(), {{"User-Agent", user_agent_}});
+        if (!res) {
+            lease.discard();
+            status = 0;
+            break;
+        }
+        status = res->status;
+        if (is_followed_redirect(status) && hops < RedirectMap::kMaxHops) {
+            auto next = docscraper::parse::URLNormalizer::resolve(url, res->get_header_value("Location"));
+            if (next && docscraper::parse::URLNormalizer::is_valid_http_url(*next)) {
+                url = std::move(*next);
+                continue;
+            }
+        }
+        if (status == 200) body = std::move(res->body);
+        break;
+    }
+    return robots_cache_.put(origin, status, std::move(body), unix_now());
+}
+
+// Request target for a robots.txt or sitemap URL, SSRF-checked and pinned like a page fetch.
+// httplib's own redirect following would connect to the next host unchecked, so these fetches
+// follow redirects themselves and pass every hop through here.
+bool CrawlFetcher::resource_target(const std::string& url, FetchTarget& target, std::string& error) {
+    if (!url_allowed_ssrf(url, config_.allow_private_network)) {
+        error = "SSRF blocked";
+        return false;
+    }
+    auto parsed = docscraper::parse::URLNormalizer::parse(url);
+    if (!parsed) {
+        error = "Invalid URL";
+        return false;
+    }
+    target = FetchTarget{};
+    if (!pin_addresses(parsed->host, target.addresses, error)) return false;
+    target.normalized_url = url;
+    target.host = parsed->host;
+    target.origin = origin_of(*parsed);
+    target.path = parsed->path.empty() ? "/" : parsed->path;
+    if (!parsed->query.empty()) target.path += "?" + parsed->query;
+    target.port = parsed->effective_port();
+    return true;
+}
+
+std::shared_ptr<const docscraper::fetch::RobotsHandler> CrawlFetcher::robots_for(
+    const docscraper::parse::URLComponents& parsed) {
+    return robots_entry(parsed)->rules;
+}
+
+// Crawl-delay only ever slows a host down, and is capped so one robots.txt cannot stall the run.
+void CrawlFetcher::apply_crawl_delay(const std::string& origin, const std::string& host,
+                                     const RobotsCache::Entry& robots) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [it, inserted] = crawl_delay_applied_.try_emplace(origin, robots.fetched_at);
+        if (!inserted && it->second == robots.fetched_at) return;
+        it->second = robots.fetched_at;
+    }
+    int seconds = robots.rules->crawl_delay_seconds("*");
+    if (seconds <= 0) return;
+    auto delay = std::min(std::chrono::milliseconds(seconds * 1000), std::chrono::milliseconds(60000));
+    if (delay > config_.rate_limit_delay_ms()) rate_limiter_.set_host_delay(host, delay);
 }
 
 std::string CrawlFetcher::fetch_robots(const std::string& base_url) {
     auto parsed = docscraper::parse::URLNormalizer::parse(base_url);
     if (!parsed) return "";
-    robots_origin_ = parsed->scheme + "://" + parsed->host;
-    if (parsed->port > 0 && !parsed->is_default_port())
-        robots_origin_ += ":" + std::to_string(parsed->port);
-
-    std::string robots_url = robots_origin_ + "/robots.txt";
-    if (!url_allowed_ssrf(robots_url, config_.allow_private_network)) return "";
-    rate_limiter_.wait_for_host(parsed->host);
+    return robots_entry(*parsed)->body;
+}
 
-    std::string path = "/robots.txt";
-    httplib::Client client(robots_origin_.c_str());
-    client.set_follow_location(true);
-    client.set_connection_timeout(10);
-    client.set_read_timeout(10);
-    auto res = client.Get(path.c_str(), {{"User-Agent", user_agent_}});
-    if (res && res->status == 200) {
-        robots_.parse(res->body);
-        return res->body;
-    }
-    return "";
+std::vector<std::string> CrawlFetcher::robots_sitemaps() {
+    auto parsed = docscraper::parse::URLNormalizer::parse(config_.url);
+    if (!parsed) return {};
+    return robots_for(*parsed)->get_sitemaps();
 }
 
-bool CrawlFetcher::is_allowed_by_robots(const std::string& url) const {
+bool CrawlFetcher::is_allowed_by_robots(const std::string& url) {
     if (!config_.respect_robots) return true;
     auto parsed = docscraper::parse::URLNormalizer::parse(url);
     if (!parsed) return false;
     std::string path = parsed->path;
     if (!parsed->query.empty()) path += "?" + parsed->query;
-    return robots_.is_allowed(path, "*");
+    return robots_for(*parsed)->is_allowed(path, "*");
+}
+
+std::optional<bool> CrawlFetcher::try_is_allowed_by_robots(const std::string& url) {
+    if (!config_.respect_robots) return true;
+    auto parsed = docscraper::parse::URLNormalizer::parse(url);
+    if (!parsed) return false;
+    std::string origin = origin_of(*parsed);
+    if (!robots_cache_.get(origin, unix_now())) {
+        std::lock_guard<std::mutex> lock(robots_fetch_mutex_);
+        if (!robots_loading_.count(origin)) {
+            // Drop finished loads, then start this origin's in the background.
+            robots_prefetch_.erase(std::remove_if(robots_prefetch_.begin(), robots_prefetch_.end(),
+                                                  [](const std::future<void>& f) {
+                                                      return f.wait_for(std::chrono::seconds(0)) ==
+                                                             std::future_status::ready;
+                                                  }),
+                                   robots_prefetch_.end());
+            robots_prefetch_.push_back(std::async(std::launch::async, [this, p = *parsed] { robots_entry(p); }));
+        }
+        return std::nullopt;
+    }
+    return is_allowed_by_robots(url);  // cached: does not block
+}
+
+bool CrawlFetcher::dns_ready(const std::string& url) {
+    std::string normalized = docscraper::parse::URLNormalizer::normalize(url, false);
+    if (!url_allowed_ssrf(normalized, config_.allow_private_network)) return true;  // refused before DNS
+    auto parsed = docscraper::parse::URLNormalizer::parse(normalized);
+    return !parsed || dns_.try_resolve(parsed->host).has_value();
 }
 
 bool CrawlFetcher::seen_add(const std::string& normalized_url) {
-    auto it = seen_urls_.find(normalized_url);
-    if (it != seen_urls_.end()) return false;
-    seen_urls_.insert(normalized_url);
-    return true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return seen_urls_.insert(normalized_url);
+}
+
+static bool is_html_content_type(const std::string& content_type) {
+    return content_type.find("text/html") != std::string::npos ||
+           content_type.find("application/xhtml") != std::string::npos;
 }
 
-std::optional<CrawlResult> CrawlFetcher::fetch(const std::string& url, int depth) {
+std::optional<CrawlResult> CrawlFetcher::begin_fetch(const std::string& url, int depth, FetchTarget& target,
+                                                     int64_t lastmod) {
     std::string normalized = docscraper::parse::URLNormalizer::normalize(url, false);
     if (!url_allowed_ssrf(normalized, config_.allow_private_network)) {
         CrawlResult r;
@@ -97,58 +296,397 @@ std::optional<CrawlResult> CrawlFetcher::fetch(const std::string& url, int depth
         return r;
     }
 
-    std::string html;
-    if (load_from_cache(normalized, html)) {
+    // Fresh cached copies are served directly; stale ones are revalidated with their validators.
+    // Pages cached without metadata are refetched.
+    auto meta = cache_meta_.get(normalized);
+    if (meta && in_cache(normalized)) {
+        std::string html;
+        bool fresh = (lastmod > 0 && meta->fetched_at >= lastmod) ||
+                     cache_entry_fresh(*meta, unix_now(), config_.cache_max_age_s);
+        if (fresh && load_from_cache(normalized, html)) {
+            CrawlResult r;
+            r.url = url;
+            r.normalized_url = normalized;
+            r.depth = depth;
+            r.html = std::move(html);
+            r.final_url = normalized;
+            r.success = true;
+            return r;
+        }
+        target.if_none_match = meta->etag;
+        target.if_modified_since = meta->last_modified;
+    }
+
+    std::vector<std::string> addresses;
+    std::string error;
+    if (!pin_addresses(parsed->host, addresses, error)) {
         CrawlResult r;
         r.url = url;
-        r.normalized_url = normalized;
-        r.depth = depth;
-        r.html = std::move(html);
-        r.final_url = normalized;
-        r.success = true;
+        r.success = false;
+        r.error = std::move(error);
         return r;
     }
 
-    rate_limiter_.wait_for_host(parsed->host);
+    target.normalized_url = normalized;
+    target.host = parsed->host;
+    target.origin = origin_of(*parsed);
+    target.path = parsed->path;
+    if (!parsed->query.empty()) target.path += "?" + parsed->query;
+    target.port = parsed->effective_port();
+    target.addresses = std::move(addresses);
+    return std::nullopt;
+}
 
-    std::string base = parsed->scheme + "://" + parsed->host;
-    if (parsed->port > 0 && !parsed->is_default_port())
-        base += ":" + std::to_string(parsed->port);
-    httplib::Client client(base.c_str());
-    client.set_follow_location(true);
-    client.set_connection_timeout(30);
-    client.set_read_timeout(30);
-    std::string path = parsed->path;
-    if (!parsed->query.empty()) path += "?" + parsed->query;
+static const char* kNotHtml = "Not HTML";
+static const char* kTooLarge = "Page exceeds --max-page-bytes";
+static const char* kBadEncoding = "Corrupt compressed body";
+
+bool CrawlFetcher::accept_headers(FetchResponse& response, int64_t content_length) const {
+    response.network_ok = true;
+    if (content_length > config_.max_page_bytes) {
+        response.error = kTooLarge;
+        return false;
+    }
+    // Non-200 bodies (304, error pages) are drained and dropped so the connection stays reusable.
+    if (response.status != 200) return true;
+    if (!is_html_content_type(response.content_type)) {
+        response.error = kNotHtml;
+        return false;
+    }
+    if (!StreamDecoder::supports_encoding(response.content_encoding)) {
+        response.error = "Unsupported Content-Encoding: " + response.content_encoding;
+        return false;
+    }
+    response.decoder = StreamDecoder::create(response.content_encoding);
+    if (!response.decoder && content_length > 0) response.body.reserve(static_cast<size_t>(content_length));
+    return true;
+}
+
+bool CrawlFetcher::append_body(FetchResponse& response, const char* data, size_t len) const {
+    response.wire_bytes += static_cast<int64_t>(len);
+    if (response.status != 200) return true;
+    // The cap applies to decoded bytes, so a small compressed body cannot expand without bound.
+    auto sink = [&](const char* chunk, size_t n) {
+        if (static_cast<int64_t>(response.body.size() + n) > config_.max_page_bytes) {
+            response.error = kTooLarge;
+            return false;
+        }
+        response.body.append(chunk, n);
+        return true;
+    };
+    if (!response.decoder) return sink(data, len);
+    if (response.decoder->write(data, len, sink)) return true;
+    if (response.error.empty()) response.error = kBadEncoding;
+    return false;
+}
+
+CrawlResult CrawlFetcher::finish_fetch(const std::string& url, int depth, const FetchTarget& target,
+                                       FetchResponse response) {
+    rate_limiter_.record_response(target.host, response.network_ok ? response.status : 0, response.latency,
+                                  docscraper::fetch::parse_retry_after(response.retry_after, unix_now()));
 
-    auto res = client.Get(path.c_str(), {{"User-Agent", user_agent_}});
     CrawlResult result;
     result.url = url;
-    result.normalized_url = normalized;
+    result.normalized_url = target.normalized_url;
     result.depth = depth;
+    result.wire_bytes = response.wire_bytes;
+    result.decoded_bytes = static_cast<int64_t>(response.body.size());
 
-    if (!res) {
+    if (!response.network_ok) {
         result.success = false;
         result.error = "Network error or timeout";
         return result;
     }
-    if (res->status != 200) {
+    if (!response.error.empty()) {
         result.success = false;
-        result.error = "HTTP " + std::to_string(res->status);
+        result.error = std::move(response.error);
         return result;
     }
-    std::string content_type = res->get_header_value("Content-Type");
-    if (content_type.find("text/html") == std::string::npos &&
-        content_type.find("application/xhtml") == std::string::npos) {
+    if (response.status == 200 && response.decoder && !response.decoder->finished()) {
         result.success = false;
-        result.error = "Not HTML";
+        result.error = kBadEncoding;  // compressed stream cut off before its end
+        return result;
+    }
+    if (response.status == 304 && target.conditional()) {
+        std::string html;
+        if (!load_from_cache(target.normalized_url, html)) {
+            result.success = false;
+            result.error = "HTTP 304 but cached copy missing";
+            return result;
+        }
+        auto meta = cache_meta_.get(target.normalized_url).value_or(CacheEntryMeta{});
+        if (!response.etag.empty()) meta.etag = response.etag;
+        if (!response.last_modified.empty()) meta.last_modified = response.last_modified;
+        if (!response.cache_control.empty()) meta.cache_control = response.cache_control;
+        meta.fetched_at = unix_now();
+        cache_meta_.put(target.normalized_url, std::move(meta));
+        result.html = std::move(html);
+        result.final_url = target.normalized_url;
+        result.success = true;
         return result;
     }
-    result.html = res->body;
-    result.final_url = normalized;
+    if (response.status != 200) {
+        result.success = false;
+        result.error = "HTTP " + std::to_string(response.status);
+        return result;
+    }
+    if (!is_html_content_type(response.content_type)) {
+        result.success = false;
+        result.error = kNotHtml;
+        return result;
+    }
+    result.html = std::move(response.body);
+    result.final_url = target.normalized_url;
     result.success = true;
-    save_to_cache(normalized, result.html);
+    if (cache_control_no_store(response.cache_control)) {
+        cache_meta_.erase(target.normalized_url);
+        return result;
+    }
+    save_to_cache(target.normalized_url, result.html);
+    cache_meta_.put(target.normalized_url, CacheEntryMeta{
+        response.etag, response.last_modified, response.cache_control, unix_now()});
     return result;
 }
 
+bool CrawlFetcher::retry_unconditional(FetchTarget& target, const FetchResponse& response) {
+    if (!response.network_ok || response.status != 304 || !target.conditional() || in_cache(target.normalized_url))
+        return false;
+    rate_limiter_.record_response(target.host, response.status, response.latency,
+                                  docscraper::fetch::parse_retry_after(response.retry_after, unix_now()));
+    cache_meta_.erase(target.normalized_url);
+    target.if_none_match.clear();
+    target.if_modified_since.clear();
+    return true;
+}
+
+std::optional<CrawlResult> CrawlFetcher::follow_redirect(const std::string& url, int depth, int hops,
+                                                         FetchTarget& target, const FetchResponse& response) {
+    std::string next;
+    if (auto done = redirect_target(url, depth, hops, target, response, next)) return done;
+    if (config_.respect_robots && !is_allowed_by_robots(next)) return redirect_blocked(url, depth, target);
+
+    FetchTarget next_target;
+    if (auto done = begin_fetch(next, depth, next_target)) {
+        done->url = url;
+        return done;
+    }
+    target = std::move(next_target);
+    return std::nullopt;
+}
+
+CrawlResult CrawlFetcher::redirect_blocked(const std::string& url, int depth, const FetchTarget& target) {
+    CrawlResult r;
+    r.url = url;
+    r.normalized_url = target.normalized_url;
+    r.depth = depth;
+    r.success = false;
+    r.error = "Redirect blocked by robots.txt";
+    return r;
+}
+
+std::optional<CrawlResult> CrawlFetcher::redirect_target(const std::string& url, int depth, int hops,
+                                                         const FetchTarget& target, const FetchResponse& response,
+                                                         std::string& next_url) {
+    rate_limiter_.record_response(target.host, response.status, response.latency,
+                                  docscraper::fetch::parse_retry_after(response.retry_after, unix_now()));
+    auto fail = [&](std::string error) {
+        CrawlResult r;
+        r.url = url;
+        r.normalized_url = target.normalized_url;
+        r.depth = depth;
+        r.success = false;
+        r.error = std::move(error);
+        return r;
+    };
+
+    auto next = docscraper::parse::URLNormalizer::resolve(target.normalized_url, response.location);
+    if (!next || !docscraper::parse::URLNormalizer::is_valid_http_url(*next))
+        return fail("HTTP " + std::to_string(response.status) + " with invalid Location");
+    std::string normalized = docscraper::parse::URLNormalizer::normalize(*next, false);
+    if (normalized == target.normalized_url) return fail("Redirect loop");
+    if (is_permanent_redirect(response.status)) redirects_.record(target.normalized_url, normalized);
+    if (hops >= RedirectMap::kMaxHops) return fail("Too many redirects");
+    next_url = std::move(normalized);
+    return std::nullopt;
+}
+
+// One GET of target, redirects not followed. The body streams straight into response.body; the
+// transfer is cancelled as soon as the headers show a non-HTML page or the decoded body passes
+// --max-page-bytes.
+FetchResponse CrawlFetcher::request(const FetchTarget& target) {
+    rate_limiter_.wait_for_host(target.host);
+
+    auto lease = pool_.acquire(target.origin);
+    pin_client(lease, target.host, target.addresses);
+    lease->set_connection_timeout(30);
+    lease->set_read_timeout(30);
+    lease->set_decompress(false);  // decoded by append_body, so wire bytes can be counted
+    lease->set_follow_location(false);
+
+    httplib::Headers headers = {{"User-Agent", user_agent_}, {"Accept-Encoding", StreamDecoder::accept_encoding()}};
+    if (!target.if_none_match.empty()) headers.emplace("If-None-Match", target.if_none_match);
+    if (!target.if_modified_since.empty()) headers.emplace("If-Modified-Since", target.if_modified_since);
+
+    FetchResponse response;
+    auto started = std::chrono::steady_clock::now();
+    auto res = lease->Get(target.path.c_str(), headers,
+        [&](const httplib::Response& r) {
+            response.latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started);
+            response.status = r.status;
+            response.retry_after = r.get_header_value("Retry-After");
+            response.location = r.get_header_value("Location");
+            response.content_type = r.get_header_value("Content-Type");
+            response.etag = r.get_header_value("ETag");
+            response.last_modified = r.get_header_value("Last-Modified");
+            response.cache_control = r.get_header_value("Cache-Control");
+            response.content_encoding = r.get_header_value("Content-Encoding");
+            int64_t length = -1;
+            if (r.has_header("Content-Length")) {
+                try { length = std::stoll(r.get_header_value("Content-Length")); } catch (...) {}
+            }
+            return accept_headers(response, length);
+        },
+        [&](const char* data, size_t len) { return append_body(response, data, len); });
+
+    // A cancelled transfer leaves the connection mid-response, so it is not reused.
+    if (!res) lease.discard();
+    return response;
+}
+
+std::optional<CrawlResult> CrawlFetcher::fetch(const std::string& url, int depth, int64_t lastmod) {
+    FetchTarget target;
+    if (auto done = begin_fetch(url, depth, target, lastmod)) return done;
+
+    // One request per hop, so each redirect target gets its own checks and connection.
+    for (int hops = 0;; ++hops) {
+        FetchResponse response = request(target);
+        if (retry_unconditional(target, response)) response = request(target);
+        if (!is_redirect(response)) return finish_fetch(url, depth, target, std::move(response));
+        if (auto done = follow_redirect(url, depth, hops, target, response)) return done;
+    }
+}
+
+// Protocol limit for one uncompressed sitemap file.
+static constexpr size_t kMaxSitemapBytes = 50u << 20;
+
+bool CrawlFetcher::fetch_sitemap(const std::string& url, const docscraper::parse::SitemapParser::Callback& on_entry,
+                                 std::string& error) {
+    // wire -> Content-Encoding decoder -> gzip decoder for .xml.gz files (sniffed by magic
+    // bytes, since they are usually served as application/gzip) -> parser.
+    docscraper::parse::SitemapParser parser(on_entry);
+    std::unique_ptr<StreamDecoder> transfer_decoder;
+    std::unique_ptr<StreamDecoder> file_decoder;
+    std::string sniff;
+    bool sniffed = false;
+    size_t decoded = 0;
+    int status = 0;
+    bool caller_stopped = false;
+
+    StreamDecoder::Sink to_parser = [&](const char* data, size_t len) {
+        decoded += len;
+        if (decoded > kMaxSitemapBytes) {
+            error = "Sitemap exceeds 50 MB";
+            return false;
+        }
+        if (parser.feed(data, len)) return true;
+        caller_stopped = true;
+        return false;
+    };
+    StreamDecoder::Sink to_file_decoder = [&](const char* data, size_t len) {
+        if (!sniffed) {
+            sniff.append(data, len);
+            if (sniff.size() < 2) return true;
+            sniffed = true;
+            if (static_cast<unsigned char>(sniff[0]) == 0x1f && static_cast<unsigned char>(sniff[1]) == 0x8b)
+                file_decoder = StreamDecoder::create("gzip");
+            data = sniff.data();
+            len = sniff.size();
+        }
+        if (!file_decoder) return to_parser(data, len);
+        if (file_decoder->write(data, len, to_parser)) return true;
+        if (error.empty()) error = "Corrupt gzip sitemap";
+        return false;
+    };
+
+    // Redirects are followed one hop at a time so each hop is SSRF-checked and pinned.
+    std::string current = url;
+    bool completed = false;
+    for (int hops = 0;; ++hops) {
+        FetchTarget target;
+        if (!resource_target(current, target, error)) return false;
+        rate_limiter_.wait_for_host(target.host);
+
+        auto lease = pool_.acquire(target.origin);
+        pin_client(lease, target.host, target.addresses);
+        lease->set_follow_location(false);
+        lease->set_decompress(false);
+        lease->set_connection_timeout(30);
+        lease->set_read_timeout(30);
+
+        std::string location;
+        auto res = lease->Get(target.path.c_str(),
+            {{"User-Agent", user_agent_}, {"Accept-Encoding", StreamDecoder::accept_encoding()}},
+            [&](const httplib::Response& r) {
+                status = r.status;
+                if (is_followed_redirect(r.status)) location = r.get_header_value("Location");
+                if (r.status != 200) return false;
+                std::string encoding = r.get_header_value("Content-Encoding");
+                if (!StreamDecoder::supports_encoding(encoding)) {
+                    error = "Unsupported Content-Encoding: " + encoding;
+                    return false;
+                }
+                transfer_decoder = StreamDecoder::create(encoding);
+                return true;
+            },
+            [&](const char* data, size_t len) {
+                if (!transfer_decoder) return to_file_decoder(data, len);
+                if (transfer_decoder->write(data, len, to_file_decoder)) return true;
+                if (error.empty()) error = "Corrupt compressed body";
+                return false;
+            });
+        if (!res) lease.discard();
+        completed = static_cast<bool>(res);
+        if (location.empty()) break;
+
+        if (hops >= RedirectMap::kMaxHops) {
+            error = "Too many redirects";
+            return false;
+        }
+        auto next = docscraper::parse::URLNormalizer::resolve(current, location);
+        if (!next || !docscraper::parse::URLNormalizer::is_valid_http_url(*next)) {
+            error = "HTTP " + std::to_string(status) + " with invalid Location";
+            return false;
+        }
+        current = std::move(*next);
+    }
+
+    // A body shorter than the magic bytes never left the sniff buffer.
+    if (completed && !sniffed && !sniff.empty()) {
+        sniffed = true;
+        to_parser(sniff.data(), sniff.size());
+    }
+
+    if (!error.empty()) return false;
+    if (status != 200) {
+        error = status ? "HTTP " + std::to_string(status) : "Network error or timeout";
+        return false;
+    }
+    // The callback stopping the parser (enough URLs) cancels the transfer but is not a failure.
+    if (caller_stopped) return true;
+    if (!completed) {
+        error = "Network error or timeout";
+        return false;
+    }
+    if (transfer_decoder && !transfer_decoder->finished()) {
+        error = "Corrupt compressed body";
+        return false;
+    }
+    if (file_decoder && !file_decoder->finished()) {
+        error = "Corrupt gzip sitemap";
+        return false;
+    }
+    return true;
+}
+
 } // namespace scrapellm
@@ -0,0 +1,205 @@
+#include "scrape_llm/crawl_frontier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+CrawlFrontier::CrawlFrontier(Options options)
+    : options_(std::move(options))
+    , segment_entries_(std::clamp<size_t>(options_.max_in_memory / 8, 1, 65536))
+{
+    if (options_.spill_dir.empty()) return;
+    // Segments left behind by a run that did not exit cleanly belong to no one now.
+    std::error_code ec;
+    for (fs::directory_iterator it(options_.spill_dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() == ".seg") fs::remove(it->path(), ec);
+    }
+}
+
+CrawlFrontier::~CrawlFrontier() {
+    clear();
+}
+
+void CrawlFrontier::clear() {
+    std::error_code ec;
+    for (auto& [key, bucket] : buckets_)
+        for (const auto& s : bucket.spilled) fs::remove(s.path, ec);
+    buckets_.clear();
+    size_ = 0;
+    in_memory_ = 0;
+}
+
+CrawlFrontier::Key CrawlFrontier::key_of(const Entry& e) const {
+    return {options_.best_first || e.pagination > 0 ? std::round(e.score) : 0.0, e.depth};
+}
+
+void CrawlFrontier::push(Entry entry) {
+    Bucket& b = buckets_[key_of(entry)];
+    // Once part of a bucket is on disk, new entries queue behind it in the tail.
+    if (b.spilled.empty() && b.tail.empty()) b.head.push_back(std::move(entry));
+    else b.tail.push_back(std::move(entry));
+    ++size_;
+    ++in_memory_;
+    if (b.tail.size() >= segment_entries_) spill_entries(b.tail, true, b, false);
+    enforce_budget(nullptr);
+}
+
+CrawlFrontier::Entry CrawlFrontier::pop() {
+    while (!buckets_.empty()) {
+        auto it = buckets_.begin();
+        Bucket& b = it->second;
+        if (b.head.empty()) {
+            if (!b.spilled.empty()) {
+                Segment seg = std::move(b.spilled.front());
+                b.spilled.pop_front();
+                if (read_segment(seg.path, seg.count, b.head)) in_memory_ += seg.count;
+                else size_ -= seg.count;  // lost segment: those URLs are dropped
+                std::error_code ec;
+                fs::remove(seg.path, ec);
+                enforce_budget(&b);
+            } else {
+                b.head.swap(b.tail);
+            }
+        }
+        if (b.head.empty()) {
+            if (b.spilled.empty() && b.tail.empty()) buckets_.erase(it);
+            continue;
+        }
+        Entry e = std::move(b.head.front());
+        b.head.pop_front();
+        --size_;
+        --in_memory_;
+        if (b.head.empty() && b.spilled.empty() && b.tail.empty()) buckets_.erase(it);
+        return e;
+    }
+    return Entry{};
+}
+
+bool CrawlFrontier::for_each(const std::function<void(const Entry&)>& on_entry,
+                             const std::function<bool(const std::string& path, size_t count)>& on_segment) const {
+    for (const auto& [key, bucket] : buckets_) {
+        for (const auto& e : bucket.head) on_entry(e);
+        for (const auto& seg : bucket.spilled)
+            if (!on_segment(seg.path, seg.count)) return false;
+        for (const auto& e : bucket.tail) on_entry(e);
+    }
+    return true;
+}
+
+// Spill from the buckets popped last until the in-memory count is back under budget. Tails go
+// to the back of their bucket's segments; heads are cut from the back and go in front of them.
+// The first pass only takes runs of at least half a segment: otherwise steady pushes into an
+// already spilled bucket would each be written out alone, one file per URL.
+void CrawlFrontier::enforce_budget(const Bucket* keep) {
+    if (options_.max_in_memory == 0 || options_.spill_dir.empty() || spill_failed_) return;
+    for (size_t min_run : {std::max<size_t>(segment_entries_ / 2, 1), size_t{1}}) {
+        for (auto it = buckets_.rbegin(); it != buckets_.rend() && in_memory_ > options_.max_in_memory;) {
+            Bucket& b = it->second;
+            bool ok = true;
+            if (&b == keep) ++it;
+            else if (b.tail.size() >= min_run) ok = spill_entries(b.tail, true, b, false);
+            else if (b.head.size() >= min_run) ok = spill_entries(b.head, false, b, true);
+            else ++it;
+            if (!ok) return;
+        }
+    }
+}
+
+// Move up to segment_entries_ entries from the front (or back) of `from` into a new segment that
+// is added to the front (or back) of bucket.spilled. Order within the segment is preserved.
+bool CrawlFrontier::spill_entries(std::deque<Entry>& from, bool from_front, Bucket& bucket, bool to_front) {
+    if (options_.max_in_memory == 0 || options_.spill_dir.empty() || spill_failed_) return false;
+    size_t n = std::min(segment_entries_, from.size());
+    std::vector<Entry> chunk;
+    chunk.reserve(n);
+    if (from_front) {
+        std::move(from.begin(), from.begin() + static_cast<long>(n), std::back_inserter(chunk));
+    } else {
+        std::move(from.end() - static_cast<long>(n), from.end(), std::back_inserter(chunk));
+    }
+    Segment seg;
+    if (!write_segment(chunk, seg)) {
+        // Keep everything in memory from now on rather than lose URLs.
+        spill_failed_ = true;
+        if (from_front) std::move(chunk.begin(), chunk.end(), from.begin());
+        else std::move(chunk.begin(), chunk.end(), from.end() - static_cast<long>(n));
+        return false;
+    }
+    if (from_front) from.erase(from.begin(), from.begin() + static_cast<long>(n));
+    else from.erase(from.end() - static_cast<long>(n), from.end());
+    in_memory_ -= n;
+    if (to_front) bucket.spilled.push_front(std::move(seg));
+    else bucket.spilled.push_back(std::move(seg));
+    return true;
+}
+
+// Segment format, per entry: u32 url length, url bytes, i32 depth, i64 lastmod, f64 score,
+// i32 pagination
+// (native byte order; segments only outlive the process as links in a checkpoint, which is
+// resumed on the machine that wrote it).
+bool CrawlFrontier::write_segment(const std::vector<Entry>& entries, Segment& segment) {
+    std::error_code ec;
+    fs::create_directories(options_.spill_dir, ec);
+    segment.path = options_.spill_dir + "/" + std::to_string(next_segment_++) + ".seg";
+    segment.count = entries.size();
+
+    std::string buf;
+    for (const auto& e : entries) {
+        uint32_t len = static_cast<uint32_t>(e.url.size());
+        int32_t depth = e.depth;
+        int32_t pagination = e.pagination;
+        buf.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        buf.append(e.url);
+        buf.append(reinterpret_cast<const char*>(&depth), sizeof(depth));
+        buf.append(reinterpret_cast<const char*>(&e.lastmod), sizeof(e.lastmod));
+        buf.append(reinterpret_cast<const char*>(&e.score), sizeof(e.score));
+        buf.append(reinterpret_cast<const char*>(&pagination), sizeof(pagination));
+    }
+    std::ofstream f(segment.path, std::ios::binary | std::ios::trunc);
+    f.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+    if (f) return true;
+    f.close();
+    fs::remove(segment.path, ec);
+    return false;
+}
+
+bool CrawlFrontier::read_segment(const std::string& path, size_t count, std::deque<Entry>& out) {
+    std::ifstream f(path, std::ios::binary);
+    std::string buf((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (!f && !f.eof()) return false;
+
+    std::deque<Entry> loaded;
+    size_t pos = 0;
+    auto read = [&](void* dst, size_t n) {
+        if (pos + n > buf.size()) return false;
+        std::memcpy(dst, buf.data() + pos, n);
+        pos += n;
+        return true;
+    };
+    for (size_t i = 0; i < count; ++i) {
+        Entry e;
+        uint32_t len = 0;
+        int32_t depth = 0;
+        int32_t pagination = 0;
+        if (!read(&len, sizeof(len)) || pos + len > buf.size()) return false;
+        e.url.assign(buf, pos, len);
+        pos += len;
+        if (!read(&depth, sizeof(depth)) || !read(&e.lastmod, sizeof(e.lastmod)) || !read(&e.score, sizeof(e.score)) ||
+            !read(&pagination, sizeof(pagination)))
+            return false;
+        e.depth = depth;
+        e.pagination = pagination;
+        loaded.push_back(std::move(e));
+    }
+    // Only handed over once the whole segment parsed.
+    std::move(loaded.begin(), loaded.end(), std::back_inserter(out));
+    return true;
+}
+
+} // namespace scrapellm
@@ -0,0 +1,490 @@
+#include "scrape_llm/crawler.hpp"
+#include "scrape_llm/content_extractor.hpp"
+#include "scrape_llm/curl_multi_fetcher.hpp"
+#include "scrape_llm/pagination.hpp"
+#include "scrape_llm/ssrf_guard.hpp"
+#include "parse/html_parser.hpp"
+#include "parse/normalizer.hpp"
+#include "utils/simhash.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <set>
+#include <thread>
+
+namespace scrapellm {
+
+static std::string extract_origin(const std::string& url) {
+    auto p = docscraper::parse::URLNormalizer::parse(url);
+    if (!p) return "";
+    std::string o = p->scheme + "://" + p->host;
+    if (p->port > 0 && !p->is_default_port()) o += ":" + std::to_string(p->port);
+    return o;
+}
+
+Crawler::Crawler(const RunConfig& config, CrawlFetcher& fetcher, LinkScorer scorer, Checkpoint* checkpoint)
+    : config_(config)
+    , fetcher_(fetcher)
+    , scorer_(std::move(scorer))
+    // Off-topic sampling needs the scorer's keywords to judge pages by.
+    , template_policy_(TemplatePolicy::Options{config.max_per_template,
+                                               scorer_.keywords().empty() ? 0 : config.template_probe, 10})
+    , checkpoint_(checkpoint)
+    , base_origin_(extract_origin(config.url))
+    , origins_{base_origin_}
+    , queue_(CrawlFrontier::Options{config.crawl_order == "best-first",
+                                    static_cast<size_t>(config.frontier_memory), config.out_dir + "/frontier"})
+{}
+
+bool Crawler::restore(RunReport& report) {
+    if (!checkpoint_) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Checkpoint::CrawlState state;
+    if (!checkpoint_->load(state, queue_, queued_)) return false;
+
+    report = std::move(state.report);
+    report.pages_crawled = 0;
+    report.pages_visited.clear();
+    restored_done_ = state.done;
+    for (auto& page : state.crawled) {
+        auto html = fetcher_.cached_page(page.normalized_url);
+        if (!html) {
+            // Evicted from the page cache since: fetch it again.
+            queue_.push({page.url, page.depth, 0, 0.0});
+            restored_done_ = false;
+            continue;
+        }
+        CrawlResult r;
+        r.url = std::move(page.url);
+        r.normalized_url = std::move(page.normalized_url);
+        r.final_url = std::move(page.final_url);
+        r.depth = page.depth;
+        r.simhash = page.simhash;
+        r.html = std::move(*html);
+        r.success = true;
+        // The graph is not checkpointed; it is rebuilt from the pages.
+        auto links = parse_page(r, config_.link_graph);
+        if (config_.link_graph) add_to_graph_locked(r.final_url, links);
+        pages_.insert(r.final_url);
+        if (r.depth == 0) origins_.insert(extract_origin(r.final_url));
+        report.pages_visited.push_back(r.url);
+        report.pages_crawled++;
+        crawled_.push_back(std::move(r));
+    }
+    restored_ = true;
+    spdlog::info("Resuming crawl: {} pages crawled, {} URLs queued{}", crawled_.size(), queue_.size(),
+                 restored_done_ ? " (crawl already complete)" : "");
+    return true;
+}
+
+std::vector<CrawlResult> Crawler::run(RunReport& report) {
+    report_ = &report;
+    run_start_ = std::chrono::steady_clock::now();
+    next_checkpoint_ = run_start_ + std::chrono::seconds(config_.checkpoint_interval_s);
+    if (!restored_) {
+        queue_.push({config_.url, 0, 0, 0.0});
+        queued_.insert(docscraper::parse::URLNormalizer::normalize(config_.url, false));
+        template_stats_locked(config_.url).queued++;  // no other thread runs yet
+        if (config_.seed_from_sitemaps) seed_from_sitemaps();
+    }
+
+    int workers = std::max(1, config_.crawl_workers);
+    if (restored_done_) {
+        // Nothing left to fetch.
+    } else if (config_.fetch_backend == "curl-multi") {
+        run_event_loop();
+    } else if (workers == 1) {
+        worker_loop();
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (int i = 0; i < workers; ++i)
+            threads.emplace_back([this] { worker_loop(); });
+        for (auto& t : threads) t.join();
+    }
+
+    int skipped = 0;
+    for (const auto& [tpl, stats] : report.templates) skipped += stats.skipped;
+    spdlog::info("Crawled {} URL templates; {} URLs passed over by the template policy", report.templates.size(), skipped);
+    report.graph_urls = static_cast<int64_t>(graph_.nodes());
+    report.graph_links = static_cast<int64_t>(graph_.edges());
+
+    if (checkpoint_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        checkpoint_locked(true);
+    }
+    report.crawl_ms += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - run_start_);
+    report_ = nullptr;
+    return std::move(crawled_);
+}
+
+bool Crawler::finished_locked() const {
+    if (static_cast<int>(crawled_.size()) >= config_.max_pages) return true;
+    return queue_.empty() && in_flight_ == 0;
+}
+
+// Above any LinkScorer score, so next pages of a listing are fetched first.
+static constexpr double kPaginationScore = 1e6;
+
+// Links go one level deeper than the page; the next page of a listing stays at its depth. Other
+// links of a page at max_depth were only needed for the link graph.
+void Crawler::enqueue_links_locked(const std::vector<LinkContext>& links, int depth, int pagination) {
+    // skip_predicted is the confidence in SKIP, so a link is dropped below 1 - skip_predicted.
+    double skip_below = link_model_ && config_.skip_predicted > 0.5 ? 1.0 - config_.skip_predicted : 0.0;
+    for (const auto& link : links) {
+        if (link.pagination) {
+            enqueue_locked(link.url, depth, 0, kPaginationScore, pagination + 1);
+        } else if (depth >= config_.max_depth) {
+            continue;
+        } else if (link.keep_probability < skip_below) {
+            // Marked as queued so it is neither fetched nor counted again.
+            if (origins_.count(extract_origin(link.url)) &&
+                queued_.insert(docscraper::parse::URLNormalizer::normalize(link.url, false)))
+                report_->links_predicted_skip++;
+        } else if (!enqueue_locked(link.url, depth + 1, 0, link.score)) {
+            boost_locked(link, depth + 1);
+        }
+    }
+}
+
+// Best-first score added per doubling of a queued URL's in-degree: a page linked from 8 crawled
+// pages gains 3 points, about one anchor keyword.
+static constexpr double kInDegreeWeight = 1.0;
+
+// For a link to a URL already queued: when this link makes its in-degree a power of two, the URL
+// is queued again with the link's score plus kInDegreeWeight per doubling. Whichever copy pops
+// first is fetched; pop_locked drops the other.
+void Crawler::boost_locked(const LinkContext& link, int depth) {
+    if (!config_.link_graph || !queue_.best_first()) return;
+    std::string norm = fetcher_.redirects().resolve(docscraper::parse::URLNormalizer::normalize(link.url, false));
+    uint32_t in_degree = graph_.in_degree(norm);
+    if (in_degree < 2 || (in_degree & (in_degree - 1)) != 0) return;
+    if (!queued_.contains(norm) || dispatched_.contains(norm) || pages_.contains(norm)) return;
+    queue_.push({norm, depth, 0, link.score + kInDegreeWeight * std::log2(static_cast<double>(in_degree))});
+    report_->links_boosted++;
+}
+
+// Pop the next URL to dispatch; false if it is a copy left behind by boost_locked.
+bool Crawler::pop_locked(QueuedUrl& qu) {
+    qu = queue_.pop();
+    if (!config_.link_graph || !queue_.best_first()) return true;
+    return dispatched_.insert(docscraper::parse::URLNormalizer::normalize(qu.url, false));
+}
+
+// Link targets are keyed like queued URLs: normalized, through known permanent redirects.
+void Crawler::add_to_graph_locked(const std::string& page_url, const std::vector<LinkContext>& links) {
+    std::vector<std::string> targets;
+    targets.reserve(links.size());
+    for (const auto& link : links)
+        targets.push_back(fetcher_.redirects().resolve(docscraper::parse::URLNormalizer::normalize(link.url, false)));
+    graph_.add_page(page_url, targets);
+}
+
+bool Crawler::enqueue_locked(const std::string& url, int depth, int64_t lastmod, double score, int pagination) {
+    if (!origins_.count(extract_origin(url))) return false;
+    std::string norm = docscraper::parse::URLNormalizer::normalize(url, false);
+    std::string fetch_url = url;
+    // A URL with a known permanent redirect is queued as its target.
+    std::string target = fetcher_.redirects().resolve(norm);
+    if (target != norm) {
+        if (!queued_.insert(norm)) return false;
+        norm = fetch_url = std::move(target);
+    }
+    if (!url_allowed_ssrf(norm, config_.allow_private_network)) return false;
+    if (!queued_.insert(norm)) return false;
+    queue_.push({fetch_url, depth, lastmod, score, pagination});
+    template_stats_locked(fetch_url).queued++;
+    return true;
+}
+
+// Past this many distinct templates (URLs that do not mask well), new ones share one entry.
+static constexpr size_t kMaxTemplates = 10000;
+
+TemplateStats& Crawler::template_stats_locked(const std::string& url) {
+    auto& templates = report_->templates;
+    std::string tpl = url_template(url);
+    auto it = templates.find(tpl);
+    if (it != templates.end()) return it->second;
+    return templates[templates.size() >= kMaxTemplates ? "(other)" : tpl];
+}
+
+// Every URL is counted under its url_template, and the TemplatePolicy decides whether it is
+// fetched, so the page budget spreads over page types rather than draining into one template.
+bool Crawler::admit_locked(const QueuedUrl& qu) {
+    TemplateStats& stats = template_stats_locked(qu.url);
+    if (!template_policy_.admit(stats)) {
+        stats.skipped++;
+        return false;
+    }
+    stats.fetched++;
+    return true;
+}
+
+// Sitemap files listed in robots.txt (else /sitemap.xml) are streamed before the crawl starts;
+// nested indexes are followed breadth-first. Page URLs enter the frontier at depth 1 with their
+// lastmod, which lets the fetcher reuse cached copies fetched since. Seeding stops at twice
+// max_pages URLs, leaving room for pages that fail.
+void Crawler::seed_from_sitemaps() {
+    constexpr int kMaxSitemapFiles = 1000;
+    const size_t limit = static_cast<size_t>(config_.max_pages) * 2;
+
+    std::deque<std::string> pending;
+    std::set<std::string> seen;
+    for (const auto& s : fetcher_.robots_sitemaps())
+        if (seen.insert(s).second) pending.push_back(s);
+    if (pending.empty()) pending.push_back(base_origin_ + "/sitemap.xml");
+
+    size_t seeded = 0;
+    int files = 0;
+    while (!pending.empty() && seeded < limit && files < kMaxSitemapFiles) {
+        std::string sitemap_url = std::move(pending.front());
+        pending.pop_front();
+        ++files;
+        std::string error;
+        bool ok = fetcher_.fetch_sitemap(sitemap_url, [&](const docscraper::parse::SitemapEntry& e) {
+            if (e.is_sitemap) {
+                if (seen.insert(e.loc).second) pending.push_back(e.loc);
+                return true;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            double score = queue_.best_first() ? scorer_.score({e.loc, "", "", 0.0}) : 0.0;
+            if (enqueue_locked(e.loc, 1, docscraper::parse::parse_w3c_datetime(e.lastmod), score)) ++seeded;
+            return seeded < limit;
+        }, error);
+        if (!ok) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            report_->errors.push_back("Sitemap " + sitemap_url + ": " + error);
+        }
+    }
+    spdlog::info("Seeded {} URLs from {} sitemap file(s)", seeded, files);
+}
+
+void Crawler::worker_loop() {
+    for (;;) {
+        QueuedUrl qu;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // Only dispatch while successes plus in-flight fetches stay under max_pages;
+            // a failed in-flight fetch frees its slot again.
+            cv_.wait(lock, [this] {
+                return finished_locked() ||
+                       (!queue_.empty() && static_cast<int>(crawled_.size()) + in_flight_ < config_.max_pages);
+            });
+            if (finished_locked()) return;
+            if (!pop_locked(qu) || !admit_locked(qu)) {
+                if (queue_.empty()) cv_.notify_all();  // may have just finished the crawl
+                continue;
+            }
+            ++in_flight_;
+            in_flight_urls_.emplace(qu.url, qu);
+        }
+
+        std::optional<CrawlResult> res;
+        if (!config_.respect_robots || fetcher_.is_allowed_by_robots(qu.url))
+            res = fetcher_.fetch(qu.url, qu.depth, qu.lastmod);
+        if (res) res->pagination = qu.pagination;
+        if (res && !claim(*res)) res.reset();
+
+        // Parsing, fingerprinting and link scoring run outside the lock so workers parse in parallel.
+        std::vector<LinkContext> links;
+        if (res) links = analyze_page(*res);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --in_flight_;
+            in_flight_urls_.erase(qu.url);
+            record_locked(std::move(res), links);
+            maybe_checkpoint_locked();
+        }
+        cv_.notify_all();
+    }
+}
+
+// Key a fetched page by its canonical link (in scope; see canonical_applies) or final URL. False
+// if that page was crawled already under another URL: the result is then only counted and listed
+// as an alias. The canonical link is found without parsing, and outside the lock.
+bool Crawler::claim(CrawlResult& res) {
+    if (!res.success) return true;
+    std::string canonical = config_.use_canonical ? canonical_link(res.html, res.final_url) : "";
+    if (!canonical.empty() && !canonical_applies(canonical, res.final_url, res.pagination)) canonical.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (res.depth == 0) origins_.insert(extract_origin(res.final_url));
+    if (!canonical.empty() && !origins_.count(extract_origin(canonical))) canonical.clear();
+    const std::string& key = canonical.empty() ? res.final_url : canonical;
+
+    bool crawled = pages_.contains(key) || pages_.contains(res.final_url);
+    if (!crawled) {
+        pages_.insert(key);
+        pages_.insert(res.final_url);
+        // Neither is fetched again should a link lead there.
+        queued_.insert(key);
+        queued_.insert(res.final_url);
+    }
+    if (crawled || docscraper::parse::URLNormalizer::normalize(res.url, false) != key)
+        report_->aliases[key].push_back(res.url);
+    if (crawled) count_transfer_locked(res);
+    return !crawled;
+}
+
+// The one parse of a page: extract its content, fingerprint the main text for near-duplicate
+// detection, check it against the schema's keywords for template yield and, if wanted, collect
+// its links. The DOM and the HTML are released before returning.
+std::vector<LinkContext> Crawler::parse_page(CrawlResult& res, bool want_links) const {
+    std::vector<LinkContext> links;
+    {
+        docscraper::parse::HTMLDocument doc(res.html);
+        res.content = extract_content(doc, res.final_url);
+        if (want_links) links = extract_links_with_context(doc, res.final_url);
+    }
+    std::string().swap(res.html);
+    const std::string& text = res.content.main_text;
+    if (config_.near_dup_distance >= 0) res.simhash = docscraper::utils::simhash64(text);
+    res.on_topic = scorer_.matches_page(text);
+    return links;
+}
+
+// Parse the page and return its links. At max_depth only pagination links are followed; the
+// rest are returned, unscored, for the link graph.
+std::vector<LinkContext> Crawler::analyze_page(CrawlResult& res) const {
+    if (!res.success) return {};
+    bool paginate = res.pagination < max_pagination_;
+    bool at_max_depth = res.depth >= config_.max_depth;
+    auto links = parse_page(res, !at_max_depth || paginate || config_.link_graph);
+    if (paginate)
+        for (auto& link : links) link.pagination = is_pagination_link(link, res.final_url);
+    if (at_max_depth) return links;
+    // Scored here, outside the crawl lock; BFS order ignores scores. The model's prediction
+    // weighs about as much as one keyword in the anchor text.
+    for (auto& link : links) {
+        if (link_model_) link.keep_probability = link_model_->predict(link);
+        if (queue_.best_first()) link.score = scorer_.score(link) + 3.0 * (2.0 * link.keep_probability - 1.0);
+    }
+    return links;
+}
+
+void Crawler::count_transfer_locked(const CrawlResult& res) {
+    if (res.wire_bytes <= 0) return;
+    auto parsed = docscraper::parse::URLNormalizer::parse(res.url);
+    auto& stats = report_->transfer_by_host[parsed ? parsed->host : res.url];
+    stats.pages++;
+    stats.wire_bytes += res.wire_bytes;
+    stats.decoded_bytes += res.decoded_bytes;
+}
+
+void Crawler::record_locked(std::optional<CrawlResult> res, const std::vector<LinkContext>& links) {
+    if (!res) return;
+    count_transfer_locked(*res);
+    if (!res->success) {
+        report_->errors.push_back(res->url + ": " + res->error);
+        return;
+    }
+    if (static_cast<int>(crawled_.size()) >= config_.max_pages) return;
+    int depth = res->depth;
+    int pagination = res->pagination;
+    if (pagination > 0) report_->pagination_pages++;
+    if (res->on_topic) template_stats_locked(res->url).on_topic++;
+    report_->pages_visited.push_back(res->url);
+    report_->pages_crawled++;
+    // Into the graph first, so links to queued URLs see their new in-degree.
+    if (config_.link_graph) add_to_graph_locked(res->final_url, links);
+    crawled_.push_back(std::move(*res));
+    enqueue_links_locked(links, depth, pagination);
+}
+
+void Crawler::maybe_checkpoint_locked() {
+    if (!checkpoint_ || config_.checkpoint_interval_s <= 0) return;
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_checkpoint_) return;
+    checkpoint_locked(false);
+    next_checkpoint_ = std::chrono::steady_clock::now() + std::chrono::seconds(config_.checkpoint_interval_s);
+}
+
+// In-flight URLs are saved as still queued, so a resumed crawl fetches them again. The page
+// cache is flushed first: the checkpoint names crawled pages whose HTML lives there.
+void Crawler::checkpoint_locked(bool done) {
+    Checkpoint::CrawlState state;
+    state.done = done;
+    state.report = *report_;
+    state.report.crawl_ms +=
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - run_start_);
+    state.crawled.reserve(crawled_.size());
+    for (const auto& r : crawled_) state.crawled.push_back({r.url, r.normalized_url, r.final_url, r.depth, r.simhash});
+    std::vector<QueuedUrl> in_flight;
+    in_flight.reserve(in_flight_urls_.size());
+    for (const auto& [url, qu] : in_flight_urls_) in_flight.push_back(qu);
+
+    fetcher_.flush_cache();
+    if (checkpoint_->save_crawl(state, queue_, in_flight, queued_))
+        spdlog::debug("Checkpoint: {} pages crawled, {} URLs queued", crawled_.size(), queue_.size() + in_flight.size());
+}
+
+void Crawler::run_event_loop() {
+    // Single-threaded: the mutex is uncontended but keeps record_locked's contract.
+    CurlMultiFetcher multi(fetcher_, config_.max_in_flight);
+    auto on_complete = [this](CrawlResult res) {
+        std::optional<CrawlResult> page;
+        std::vector<LinkContext> links;
+        std::string url = res.url;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = in_flight_urls_.find(url);
+            if (it != in_flight_urls_.end()) res.pagination = it->second.pagination;
+        }
+        if (claim(res)) {
+            links = analyze_page(res);
+            page = std::move(res);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        --in_flight_;
+        in_flight_urls_.erase(url);
+        record_locked(std::move(page), links);
+        maybe_checkpoint_locked();
+    };
+
+    // URLs whose origin's robots.txt is still loading in the background. They hold their in-flight
+    // slot (and are checkpointed as queued) until it is known whether they may be fetched.
+    std::vector<QueuedUrl> robots_pending;
+    for (;;) {
+        std::vector<QueuedUrl> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (finished_locked()) return;
+            while (!queue_.empty() && static_cast<int>(crawled_.size()) + in_flight_ < config_.max_pages) {
+                QueuedUrl qu;
+                if (!pop_locked(qu) || !admit_locked(qu)) continue;
+                ++in_flight_;
+                in_flight_urls_.emplace(qu.url, qu);
+                ready.push_back(std::move(qu));
+            }
+        }
+        // Robots checks run outside the lock and never block this thread on a download.
+        ready.insert(ready.end(), std::make_move_iterator(robots_pending.begin()),
+                     std::make_move_iterator(robots_pending.end()));
+        robots_pending.clear();
+        size_t blocked = 0;
+        for (auto& qu : ready) {
+            std::optional<bool> allowed = fetcher_.try_is_allowed_by_robots(qu.url);
+            if (!allowed) {
+                robots_pending.push_back(std::move(qu));
+            } else if (*allowed) {
+                multi.submit(qu.url, qu.depth, qu.lastmod);
+            } else {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --in_flight_;
+                in_flight_urls_.erase(qu.url);
+                ++blocked;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (in_flight_ == 0) {
+                if (blocked > 0) continue;  // the freed slots may admit more of the frontier
+                return;  // frontier drained or page budget reached
+            }
+        }
+        multi.poll(std::chrono::milliseconds(robots_pending.empty() ? 100 : 10), on_complete);
+    }
+}
+
+} // namespace scrapellm
@@ -0,0 +1,373 @@
+#include "scrape_llm/curl_multi_fetcher.hpp"
+#include "scrape_llm/ssrf_guard.hpp"
+#include "scrape_llm/stream_decoder.hpp"
+#include <curl/curl.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <mutex>
+
+namespace scrapellm {
+
+using Clock = std::chrono::steady_clock;
+
+struct CurlMultiFetcher::Transfer {
+    CURL* easy = nullptr;
+    curl_slist* headers = nullptr;
+    curl_slist* resolve = nullptr;  // host:port:address pin from begin_fetch
+    CrawlFetcher* fetcher = nullptr;
+    std::string url;
+    int depth = 0;
+    int hops = 0;               // redirects followed before this request
+    FetchTarget target;
+    FetchResponse response;     // body streams straight in
+    bool headers_checked = false;
+};
+
+struct CurlMultiFetcher::Callbacks {
+    static int socket(CURL*, curl_socket_t s, int what, void* userp, void*) {
+        auto* self = static_cast<CurlMultiFetcher*>(userp);
+        if (what == CURL_POLL_REMOVE) self->sockets_.erase(static_cast<int>(s));
+        else self->sockets_[static_cast<int>(s)] = what;
+        return 0;
+    }
+
+    static int timer(CURLM*, long timeout_ms, void* userp) {
+        auto* self = static_cast<CurlMultiFetcher*>(userp);
+        self->timer_ms_ = timeout_ms;
+        self->timer_set_at_ = Clock::now();
+        return 0;
+    }
+
+    // Keeps the headers of the final response; interim ones (100 Continue) are discarded.
+    static size_t header(char* ptr, size_t size, size_t nmemb, void* userdata) {
+        auto* t = static_cast<Transfer*>(userdata);
+        size_t n = size * nmemb;
+        std::string line(ptr, n);
+        if (line.rfind("HTTP/", 0) == 0) {
+            t->response.etag.clear();
+            t->response.last_modified.clear();
+            t->response.cache_control.clear();
+            t->response.content_encoding.clear();
+            t->response.retry_after.clear();
+            t->response.location.clear();
+            return n;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) return n;
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        size_t start = line.find_first_not_of(" \t", colon + 1);
+        size_t end = line.find_last_not_of(" \t\r\n");
+        std::string value = (start == std::string::npos || end < start) ? "" : line.substr(start, end - start + 1);
+        if (name == "etag") t->response.etag = value;
+        else if (name == "last-modified") t->response.last_modified = value;
+        else if (name == "cache-control") t->response.cache_control = value;
+        else if (name == "content-encoding") t->response.content_encoding = value;
+        else if (name == "retry-after") t->response.retry_after = value;
+        else if (name == "location") t->response.location = value;
+        return n;
+    }
+
+    // First body chunk: check status and headers so non-HTML transfers stop before the body
+    // is downloaded. Returning short makes libcurl abort with CURLE_WRITE_ERROR.
+    static size_t write(char* ptr, size_t size, size_t nmemb, void* userdata) {
+        auto* t = static_cast<Transfer*>(userdata);
+        size_t n = size * nmemb;
+        if (!t->headers_checked) {
+            t->headers_checked = true;
+            read_status(t);
+            curl_off_t length = -1;
+            curl_easy_getinfo(t->easy, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+            if (!t->fetcher->accept_headers(t->response, static_cast<int64_t>(length))) return 0;
+        }
+        return t->fetcher->append_body(t->response, ptr, n) ? n : 0;
+    }
+
+    // The host is pinned to checked addresses; as a second line of defence every address libcurl
+    // is about to connect to is checked as well. Refusing the socket fails the transfer.
+    static curl_socket_t opensocket(void*, curlsocktype, curl_sockaddr* address) {
+        char ip[INET6_ADDRSTRLEN] = {};
+        const void* raw = nullptr;
+        if (address->family == AF_INET) raw = &reinterpret_cast<sockaddr_in*>(&address->addr)->sin_addr;
+        else if (address->family == AF_INET6) raw = &reinterpret_cast<sockaddr_in6*>(&address->addr)->sin6_addr;
+        if (!raw || !inet_ntop(address->family, raw, ip, sizeof(ip)) || is_private_address(ip)) return CURL_SOCKET_BAD;
+        return ::socket(address->family, address->socktype, address->protocol);
+    }
+
+    static void read_status(Transfer* t) {
+        long status = 0;
+        curl_easy_getinfo(t->easy, CURLINFO_RESPONSE_CODE, &status);
+        t->response.status = static_cast<int>(status);
+        char* content_type = nullptr;
+        curl_easy_getinfo(t->easy, CURLINFO_CONTENT_TYPE, &content_type);
+        t->response.content_type = content_type ? content_type : "";
+    }
+};
+
+CurlMultiFetcher::CurlMultiFetcher(CrawlFetcher& fetcher, int max_in_flight)
+    : fetcher_(fetcher)
+    , max_in_flight_(std::max(1, max_in_flight))
+    , scheduler_(fetcher.rate_limiter())
+{
+    static std::once_flag curl_init;
+    std::call_once(curl_init, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    CURLM* multi = curl_multi_init();
+    curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, &Callbacks::socket);
+    curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, &Callbacks::timer);
+    curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(fetcher_.config().connections_per_host));
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+    multi_ = multi;
+}
+
+CurlMultiFetcher::~CurlMultiFetcher() {
+    // Abort whatever is still in flight.
+    CURLM* multi = static_cast<CURLM*>(multi_);
+    for (Transfer* t : transfers_) {
+        curl_multi_remove_handle(multi, t->easy);
+        curl_easy_cleanup(t->easy);
+        curl_slist_free_all(t->headers);
+        curl_slist_free_all(t->resolve);
+        delete t;
+    }
+    curl_multi_cleanup(multi);
+}
+
+void CurlMultiFetcher::submit(const std::string& url, int depth, int64_t lastmod) {
+    Parked p;
+    p.url = url;
+    p.depth = depth;
+    p.lastmod = lastmod;
+    p.fetch_url = url;
+    parked_.push_back(std::move(p));
+}
+
+// Hand parked requests to begin_fetch once it cannot block; the rest stay for the next poll.
+void CurlMultiFetcher::start_parked() {
+    std::vector<Parked> still;
+    for (auto& p : parked_) {
+        if (!p.robots_checked) {
+            std::optional<bool> allowed = fetcher_.try_is_allowed_by_robots(p.fetch_url);
+            if (!allowed) {
+                still.push_back(std::move(p));
+                continue;
+            }
+            if (!*allowed) {
+                ready_.push_back(CrawlFetcher::redirect_blocked(p.url, p.depth, p.from));
+                continue;
+            }
+            p.robots_checked = true;
+        }
+        if (!fetcher_.dns_ready(p.fetch_url)) {
+            still.push_back(std::move(p));
+            continue;
+        }
+        Waiting w{p.url, p.depth, {}, p.hops};
+        if (auto done = fetcher_.begin_fetch(p.fetch_url, p.depth, w.target, p.lastmod)) {
+            done->url = std::move(p.url);
+            ready_.push_back(std::move(*done));
+            continue;
+        }
+        enqueue(std::move(w));
+    }
+    parked_.swap(still);
+}
+
+void CurlMultiFetcher::enqueue(Waiting w) {
+    std::string host = w.target.host;
+    waiting_[host].push_back(std::move(w));
+    ++waiting_count_;
+    scheduler_.push(host);
+}
+
+void CurlMultiFetcher::start_ready_transfers(Clock::time_point now) {
+    // Each released host starts its oldest request and, if it has more, is rescheduled
+    // behind the slot it just reserved.
+    while (static_cast<int>(transfers_.size()) < max_in_flight_) {
+        auto host = scheduler_.pop_ready(now);
+        if (!host) break;
+        auto it = waiting_.find(*host);
+        if (it == waiting_.end()) continue;
+        Waiting w = std::move(it->second.front());
+        it->second.pop_front();
+        --waiting_count_;
+        fetcher_.rate_limiter().reserve(*host);
+        if (it->second.empty()) waiting_.erase(it);
+        else scheduler_.push(*host);
+        start_transfer(std::move(w));
+    }
+}
+
+void CurlMultiFetcher::start_transfer(Waiting w) {
+    auto* t = new Transfer;
+    t->fetcher = &fetcher_;
+    t->url = std::move(w.url);
+    t->depth = w.depth;
+    t->hops = w.hops;
+    t->target = std::move(w.target);
+    t->easy = curl_easy_init();
+    std::string full_url = t->target.origin + t->target.path;
+
+    CURL* easy = t->easy;
+    curl_easy_setopt(easy, CURLOPT_URL, full_url.c_str());
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, t);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, &Callbacks::write);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, t);
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, &Callbacks::header);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, t);
+    // Accept-Encoding is sent by hand rather than via CURLOPT_ACCEPT_ENCODING so the body reaches
+    // the write callback still encoded and CrawlFetcher can count wire bytes while decoding.
+    t->headers = curl_slist_append(t->headers, (std::string("Accept-Encoding: ") + StreamDecoder::accept_encoding()).c_str());
+    if (!t->target.if_none_match.empty())
+        t->headers = curl_slist_append(t->headers, ("If-None-Match: " + t->target.if_none_match).c_str());
+    if (!t->target.if_modified_since.empty())
+        t->headers = curl_slist_append(t->headers, ("If-Modified-Since: " + t->target.if_modified_since).c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, t->headers);
+    // Connect to the addresses CrawlFetcher resolved and checked instead of resolving again.
+    std::string pin = t->target.host + ":" + std::to_string(t->target.port) + ":";
+    for (size_t i = 0; i < t->target.addresses.size(); ++i) {
+        const std::string& ip = t->target.addresses[i];
+        pin += (i ? "," : "") + (ip.find(':') == std::string::npos ? ip : "[" + ip + "]");
+    }
+    t->resolve = curl_slist_append(nullptr, pin.c_str());
+    curl_easy_setopt(easy, CURLOPT_RESOLVE, t->resolve);
+    if (!fetcher_.config().allow_private_network)
+        curl_easy_setopt(easy, CURLOPT_OPENSOCKETFUNCTION, &Callbacks::opensocket);
+    curl_easy_setopt(easy, CURLOPT_USERAGENT, fetcher_.user_agent().c_str());
+    curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 0L);  // see collect_completed
+#if LIBCURL_VERSION_NUM >= 0x075500
+    curl_easy_setopt(easy, CURLOPT_PROTOCOLS_STR, "http,https");
+#endif
+    curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT, 30L);
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT, 30L);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_MAXFILESIZE_LARGE, static_cast<curl_off_t>(fetcher_.config().max_page_bytes));
+    transfers_.insert(t);
+    curl_multi_add_handle(static_cast<CURLM*>(multi_), easy);
+}
+
+void CurlMultiFetcher::socket_action(int s, int ev_bitmask) {
+    int running = 0;
+    curl_multi_socket_action(static_cast<CURLM*>(multi_), static_cast<curl_socket_t>(s), ev_bitmask, &running);
+}
+
+void CurlMultiFetcher::collect_completed(const Completion& on_complete) {
+    CURLM* multi = static_cast<CURLM*>(multi_);
+    int left = 0;
+    while (CURLMsg* msg = curl_multi_info_read(multi, &left)) {
+        if (msg->msg != CURLMSG_DONE) continue;
+        CURL* easy = msg->easy_handle;
+        Transfer* t = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, &t);
+
+        FetchResponse response = std::move(t->response);
+        if (msg->data.result == CURLE_OK) {
+            Callbacks::read_status(t);  // empty bodies never reach the write callback
+            response.status = t->response.status;
+            response.content_type = t->response.content_type;
+            response.network_ok = true;
+        } else if (msg->data.result == CURLE_FILESIZE_EXCEEDED) {
+            Callbacks::read_status(t);
+            response.status = t->response.status;
+            response.network_ok = true;
+            response.error = "Page exceeds --max-page-bytes";
+        } else if (!t->headers_checked || response.error.empty()) {
+            response.network_ok = false;  // aborted by the network, not by accept_headers/append_body
+        }
+
+        curl_off_t ttfb_us = 0;
+        curl_easy_getinfo(easy, CURLINFO_STARTTRANSFER_TIME_T, &ttfb_us);
+        response.latency = std::chrono::milliseconds(ttfb_us / 1000);
+
+        curl_multi_remove_handle(multi, easy);
+        curl_easy_cleanup(easy);
+        transfers_.erase(t);
+        curl_slist_free_all(t->headers);
+        curl_slist_free_all(t->resolve);
+        std::unique_ptr<Transfer> done(t);
+
+        // A redirect is parked as a new request for its target, so the hop is checked against
+        // robots.txt, rate limited and pinned like any other URL without blocking this thread.
+        if (CrawlFetcher::is_redirect(response)) {
+            std::string next;
+            if (auto result = fetcher_.redirect_target(done->url, done->depth, done->hops, done->target, response, next)) {
+                on_complete(std::move(*result));
+            } else {
+                parked_.push_back(Parked{std::move(done->url), done->depth, 0, std::move(next), done->hops + 1,
+                                         std::move(done->target), false});
+            }
+            continue;
+        }
+        // The cached copy went missing while the revalidation was in flight: ask again in full.
+        if (fetcher_.retry_unconditional(done->target, response)) {
+            Waiting w{std::move(done->url), done->depth, std::move(done->target), done->hops};
+            enqueue(std::move(w));
+            continue;
+        }
+        on_complete(fetcher_.finish_fetch(done->url, done->depth, done->target, std::move(response)));
+    }
+}
+
+std::chrono::milliseconds CurlMultiFetcher::next_wait(Clock::time_point now, std::chrono::milliseconds cap) const {
+    auto wait = cap;
+    if (timer_ms_ >= 0) {
+        auto due = timer_set_at_ + std::chrono::milliseconds(timer_ms_);
+        wait = std::min(wait, std::chrono::duration_cast<std::chrono::milliseconds>(due - now));
+    }
+    if (!parked_.empty()) wait = std::min(wait, std::chrono::milliseconds(10));  // background lookups
+    if (static_cast<int>(transfers_.size()) < max_in_flight_) {
+        if (auto next = scheduler_.next_ready()) {
+            if (*next <= now) return std::chrono::milliseconds(0);
+            wait = std::min(wait, std::chrono::duration_cast<std::chrono::milliseconds>(*next - now) +
+                                      std::chrono::milliseconds(1));
+        }
+    }
+    return std::max(wait, std::chrono::milliseconds(0));
+}
+
+void CurlMultiFetcher::poll(std::chrono::milliseconds timeout, const Completion& on_complete) {
+    start_parked();
+    for (auto& r : ready_) on_complete(std::move(r));
+    ready_.clear();
+
+    auto now = Clock::now();
+    start_ready_transfers(now);
+
+    std::vector<pollfd> fds;
+    fds.reserve(sockets_.size());
+    for (const auto& [fd, what] : sockets_) {
+        short events = 0;
+        if (what & CURL_POLL_IN) events |= POLLIN;
+        if (what & CURL_POLL_OUT) events |= POLLOUT;
+        fds.push_back({fd, events, 0});
+    }
+
+    int wait_ms = static_cast<int>(next_wait(now, timeout).count());
+    int n = ::poll(fds.data(), fds.size(), wait_ms);
+
+    if (n > 0) {
+        for (const auto& p : fds) {
+            if (!p.revents) continue;
+            int mask = 0;
+            if (p.revents & POLLIN) mask |= CURL_CSELECT_IN;
+            if (p.revents & POLLOUT) mask |= CURL_CSELECT_OUT;
+            if (p.revents & (POLLERR | POLLHUP)) mask |= CURL_CSELECT_ERR;
+            socket_action(p.fd, mask);
+        }
+    }
+    if (timer_ms_ >= 0 && Clock::now() >= timer_set_at_ + std::chrono::milliseconds(timer_ms_)) {
+        timer_ms_ = -1;
+        socket_action(CURL_SOCKET_TIMEOUT, 0);
+    }
+
+    collect_completed(on_complete);
+}
+
+} // namespace scrapellm
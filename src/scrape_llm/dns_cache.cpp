@@ -0,0 +1,100 @@
+#include "scrape_llm/dns_cache.hpp"
+#include <algorithm>
+#include <memory>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+
+namespace scrapellm {
+
+DnsCache::DnsCache(Options options)
+    : options_(options)
+{}
+
+DnsCache::~DnsCache() {
+    std::vector<std::future<void>> background;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        background.swap(background_);
+    }
+    for (auto& f : background) f.wait();
+}
+
+std::string DnsCache::unbracket(const std::string& host) {
+    if (host.size() > 2 && host.front() == '[' && host.back() == ']') return host.substr(1, host.size() - 2);
+    return host;
+}
+
+DnsCache::Result DnsCache::resolve(const std::string& host) {
+    std::string name = unbracket(host);
+
+    std::promise<Result> promise;
+    std::shared_future<Result> cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(name);
+        if (it != entries_.end() && Clock::now() < it->second.expires) cached = it->second.result;
+        else entries_[name] = Entry{promise.get_future().share(), Clock::time_point::max()};
+    }
+    // Wait outside the lock so lookups for other hosts are not held up.
+    if (cached.valid()) return cached.get();
+    return complete(name, promise);
+}
+
+std::optional<DnsCache::Result> DnsCache::try_resolve(const std::string& host) {
+    std::string name = unbracket(host);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(name);
+    if (it != entries_.end() && Clock::now() < it->second.expires) {
+        if (it->second.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return std::nullopt;
+        return it->second.result.get();
+    }
+    auto promise = std::make_shared<std::promise<Result>>();
+    entries_[name] = Entry{promise->get_future().share(), Clock::time_point::max()};
+    // Drop finished lookups, then start this one.
+    background_.erase(std::remove_if(background_.begin(), background_.end(),
+                                     [](const std::future<void>& f) {
+                                         return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                                     }),
+                      background_.end());
+    background_.push_back(std::async(std::launch::async, [this, name, promise] { complete(name, *promise); }));
+    return std::nullopt;
+}
+
+// Publish the lookup to waiters, then start the entry's ttl.
+DnsCache::Result DnsCache::complete(const std::string& name, std::promise<Result>& promise) {
+    Result r = lookup(name);
+    promise.set_value(r);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(name);
+    if (it != entries_.end()) it->second.expires = Clock::now() + (r.ok() ? options_.ttl : options_.negative_ttl);
+    return r;
+}
+
+DnsCache::Result DnsCache::lookup(const std::string& host) {
+    Result r;
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_ADDRCONFIG;  // no IPv6 results on hosts without IPv6
+    addrinfo* list = nullptr;
+    int rc = getaddrinfo(host.c_str(), nullptr, &hints, &list);
+    if (rc != 0) {
+        r.error = gai_strerror(rc);
+        return r;
+    }
+    for (addrinfo* ai = list; ai; ai = ai->ai_next) {
+        char buf[INET6_ADDRSTRLEN] = {};
+        const void* addr = nullptr;
+        if (ai->ai_family == AF_INET) addr = &reinterpret_cast<sockaddr_in*>(ai->ai_addr)->sin_addr;
+        else if (ai->ai_family == AF_INET6) addr = &reinterpret_cast<sockaddr_in6*>(ai->ai_addr)->sin6_addr;
+        if (!addr || !inet_ntop(ai->ai_family, addr, buf, sizeof(buf))) continue;
+        if (std::find(r.addresses.begin(), r.addresses.end(), buf) == r.addresses.end())
+            r.addresses.emplace_back(buf);
+    }
+    freeaddrinfo(list);
+    if (r.addresses.empty()) r.error = "no addresses";
+    return r;
+}
+
+} // namespace scrapellm
@@ -0,0 +1,95 @@
+#include "scrape_llm/incremental_store.hpp"
+#include "scrape_llm/report_generator.hpp"
+#include "utils/hash.hpp"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <fstream>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+static constexpr int kFormatVersion = 1;
+
+IncrementalStore::IncrementalStore(const std::string& out_dir, std::string schema_key)
+    : path_(out_dir + "/cache/records.jsonl")
+    , schema_key_(std::move(schema_key))
+{}
+
+std::string IncrementalStore::content_hash(const ExtractedContent& content) {
+    // Fields are separated by a byte that cannot occur in the text.
+    std::string data = content.title + '\x1f' + content.meta_description + '\x1f';
+    for (const auto& h : content.headings) data += h + '\x1e';
+    data += '\x1f' + content.main_text + '\x1f';
+    for (const auto& t : content.tables_tsv) data += t + '\x1e';
+    return docscraper::utils::content_hash(data);
+}
+
+// File layout: a header line {"version", "schema_key"}, then one line per URL.
+size_t IncrementalStore::load() {
+    entries_.clear();
+    std::ifstream f(path_);
+    std::string line;
+    if (!std::getline(f, line)) return 0;
+    json header = json::parse(line, nullptr, false);
+    if (header.is_discarded() || header.value("version", 0) != kFormatVersion) return 0;
+    if (header.value("schema_key", "") != schema_key_) {
+        spdlog::info("Incremental: schema changed since the last run; all pages will be processed");
+        return 0;
+    }
+    while (std::getline(f, line)) {
+        json j = json::parse(line, nullptr, false);
+        if (j.is_discarded() || !j.is_object()) continue;
+        Entry e;
+        e.content_hash = j.value("content_hash", "");
+        e.decision.keep = j.value("keep", false);
+        e.decision.reason = j.value("reason", "");
+        e.parsed = j.value("parsed", false);
+        if (e.parsed) e.page = parsed_page_from_json(j.value("page", json::object()));
+        entries_[j.value("url", "")] = std::move(e);
+    }
+    return entries_.size();
+}
+
+bool IncrementalStore::save() const {
+    std::error_code ec;
+    fs::create_directories(fs::path(path_).parent_path(), ec);
+    std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        f << json{{"version", kFormatVersion}, {"schema_key", schema_key_}}.dump() << '\n';
+        for (const auto& [url, e] : entries_) {
+            json j = {{"url", url}, {"content_hash", e.content_hash}, {"keep", e.decision.keep},
+                      {"reason", e.decision.reason}, {"parsed", e.parsed}};
+            if (e.parsed) j["page"] = parsed_page_to_json(e.page);
+            f << j.dump() << '\n';
+        }
+        if (!f) {
+            spdlog::warn("Incremental: could not write {}", tmp);
+            return false;
+        }
+    }
+    fs::rename(tmp, path_, ec);
+    if (ec) spdlog::warn("Incremental: could not replace {}: {}", path_, ec.message());
+    return !ec;
+}
+
+const IncrementalStore::Entry* IncrementalStore::unchanged(const std::string& url, const std::string& content_hash) const {
+    auto it = entries_.find(url);
+    if (it == entries_.end() || it->second.content_hash != content_hash) return nullptr;
+    return &it->second;
+}
+
+void IncrementalStore::record_relevance(const std::string& url, const std::string& content_hash,
+                                        const RelevanceDecision& decision) {
+    entries_[url] = Entry{content_hash, decision, false, {}};
+}
+
+void IncrementalStore::record_parsed(const std::string& url, const std::string& content_hash, const ParsedPage& page) {
+    Entry& e = entries_[url];
+    if (e.content_hash != content_hash) e = Entry{content_hash, RelevanceDecision{true, "", false}, false, {}};
+    e.parsed = true;
+    e.page = page;
+}
+
+} // namespace scrapellm
@@ -0,0 +1,145 @@
+#include "scrape_llm/link_classifier.hpp"
+#include "scrape_llm/url_template.hpp"
+#include "parse/normalizer.hpp"
+#include "utils/hash.hpp"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kFormatVersion = 1;
+constexpr size_t kBuckets = 1u << 18;
+constexpr double kLearningRate = 0.2;
+constexpr float kMaxWeight = 8.0f;
+
+// Lowercased runs of letters and digits; numbers and single characters carry no signal.
+void add_words(const std::string& text, const char* prefix, std::vector<std::string>& out) {
+    std::string word;
+    auto flush = [&] {
+        bool numeric = std::all_of(word.begin(), word.end(), [](unsigned char c) { return std::isdigit(c); });
+        if (word.size() >= 2 && !numeric) out.push_back(prefix + word);
+        word.clear();
+    };
+    for (unsigned char c : text) {
+        if (std::isalnum(c)) word += static_cast<char>(std::tolower(c));
+        else flush();
+    }
+    flush();
+}
+
+std::vector<uint32_t> features(const std::string& url, const std::string& anchor) {
+    std::vector<std::string> names{"bias", "tpl:" + url_template(url)};
+    if (auto parsed = docscraper::parse::URLNormalizer::parse(url)) {
+        add_words(parsed->path, "path:", names);
+        size_t pos = 0;
+        while (pos < parsed->query.size()) {
+            size_t amp = parsed->query.find('&', pos);
+            if (amp == std::string::npos) amp = parsed->query.size();
+            std::string param = parsed->query.substr(pos, amp - pos);
+            if (!param.empty()) names.push_back("query:" + param.substr(0, param.find('=')));
+            pos = amp + 1;
+        }
+    }
+    add_words(anchor, "text:", names);
+
+    std::vector<uint32_t> out;
+    out.reserve(names.size());
+    for (const auto& n : names) out.push_back(static_cast<uint32_t>(docscraper::utils::fingerprint64(n) % kBuckets));
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+} // namespace
+
+LinkClassifier::LinkClassifier(const std::string& out_dir, std::string schema_key)
+    : path_(out_dir + "/cache/link_model.json")
+    , schema_key_(std::move(schema_key))
+    , weights_(kBuckets, 0.0f)
+{}
+
+// File layout: {"version", "schema_key", "kept", "skipped", "weights": [[bucket, weight], ...]}
+// with only non-zero weights.
+int64_t LinkClassifier::load() {
+    std::ifstream f(path_);
+    if (!f) return 0;
+    nlohmann::json j = nlohmann::json::parse(f, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) return 0;
+    try {
+        if (j.value("version", 0) != kFormatVersion) return 0;
+        if (j.value("schema_key", "") != schema_key_) {
+            spdlog::info("Link model: schema changed since the last run; starting untrained");
+            return 0;
+        }
+        std::fill(weights_.begin(), weights_.end(), 0.0f);
+        if (j.contains("weights") && j["weights"].is_array()) {
+            for (const auto& w : j["weights"]) {
+                if (!w.is_array() || w.size() != 2 || !w[0].is_number_unsigned() || !w[1].is_number()) continue;
+                size_t bucket = w[0].get<size_t>();
+                if (bucket < kBuckets) weights_[bucket] = w[1].get<float>();
+            }
+        }
+        kept_ = j.value("kept", static_cast<int64_t>(0));
+        skipped_ = j.value("skipped", static_cast<int64_t>(0));
+    } catch (...) {
+        // Corrupt file: the model is relearned from this run's pages.
+        spdlog::warn("Link model: unreadable {}; starting untrained", path_);
+        std::fill(weights_.begin(), weights_.end(), 0.0f);
+        kept_ = 0;
+        skipped_ = 0;
+        return 0;
+    }
+    return examples();
+}
+
+bool LinkClassifier::save() const {
+    nlohmann::json weights = nlohmann::json::array();
+    for (size_t i = 0; i < weights_.size(); ++i)
+        if (weights_[i] != 0.0f) weights.push_back({i, weights_[i]});
+    nlohmann::json j = {{"version", kFormatVersion}, {"schema_key", schema_key_}, {"kept", kept_},
+                        {"skipped", skipped_}, {"weights", std::move(weights)}};
+    std::error_code ec;
+    fs::create_directories(fs::path(path_).parent_path(), ec);
+    std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        f << j.dump();
+        if (!f) {
+            spdlog::warn("Link model: could not write {}", tmp);
+            return false;
+        }
+    }
+    fs::rename(tmp, path_, ec);
+    if (ec) spdlog::warn("Link model: could not replace {}: {}", path_, ec.message());
+    return !ec;
+}
+
+double LinkClassifier::probability(const std::vector<uint32_t>& features) const {
+    double z = 0.0;
+    for (uint32_t f : features) z += weights_[f];
+    return 1.0 / (1.0 + std::exp(-z));
+}
+
+double LinkClassifier::predict(const LinkContext& link) const {
+    if (!ready()) return 0.5;
+    return probability(features(link.url, link.anchor));
+}
+
+void LinkClassifier::update(const std::string& url, const std::string& title, bool keep) {
+    auto x = features(url, title);
+    double gradient = probability(x) - (keep ? 1.0 : 0.0);
+    for (uint32_t f : x)
+        weights_[f] = std::clamp(static_cast<float>(weights_[f] - kLearningRate * gradient), -kMaxWeight, kMaxWeight);
+    (keep ? kept_ : skipped_)++;
+}
+
+} // namespace scrapellm
@@ -0,0 +1,92 @@
+#include "scrape_llm/link_graph.hpp"
+#include "utils/hash.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+uint32_t LinkGraph::intern(const std::string& url) {
+    auto [it, inserted] = ids_.try_emplace(docscraper::utils::fingerprint64(url), static_cast<uint32_t>(urls_.size()));
+    if (inserted) {
+        urls_.push_back(url);
+        in_degree_.push_back(0);
+        row_of_.push_back(-1);
+    }
+    return it->second;
+}
+
+std::optional<uint32_t> LinkGraph::find(const std::string& url) const {
+    auto it = ids_.find(docscraper::utils::fingerprint64(url));
+    if (it == ids_.end()) return std::nullopt;
+    return it->second;
+}
+
+void LinkGraph::add_page(const std::string& url, const std::vector<std::string>& links) {
+    uint32_t source = intern(url);
+    if (row_of_[source] >= 0) return;
+    size_t begin = targets_.size();
+    for (const auto& link : links) {
+        uint32_t target = intern(link);
+        if (target != source) targets_.push_back(target);
+    }
+    std::sort(targets_.begin() + static_cast<long>(begin), targets_.end());
+    targets_.erase(std::unique(targets_.begin() + static_cast<long>(begin), targets_.end()), targets_.end());
+    for (size_t i = begin; i < targets_.size(); ++i) in_degree_[targets_[i]]++;
+    row_of_[source] = static_cast<int32_t>(row_node_.size());
+    row_node_.push_back(source);
+    row_offsets_.push_back(targets_.size());
+}
+
+uint32_t LinkGraph::in_degree(const std::string& url) const {
+    auto id = find(url);
+    return id ? in_degree_[*id] : 0;
+}
+
+std::vector<double> LinkGraph::pagerank(int iterations, double damping) const {
+    const size_t n = urls_.size();
+    if (n == 0) return {};
+    std::vector<double> rank(n, 1.0 / static_cast<double>(n));
+    std::vector<double> next(n);
+    for (int it = 0; it < iterations; ++it) {
+        // Rank that follows no link: from pages without out-links and from uncrawled nodes.
+        double linked = 0.0;
+        std::fill(next.begin(), next.end(), 0.0);
+        for (size_t r = 0; r < row_node_.size(); ++r) {
+            uint64_t begin = row_offsets_[r], end = row_offsets_[r + 1];
+            if (begin == end) continue;
+            double from = rank[row_node_[r]];
+            linked += from;
+            double share = damping * from / static_cast<double>(end - begin);
+            for (uint64_t e = begin; e < end; ++e) next[targets_[e]] += share;
+        }
+        double spread = ((1.0 - damping) + damping * (1.0 - linked)) / static_cast<double>(n);
+        for (size_t i = 0; i < n; ++i) rank[i] = next[i] + spread;
+    }
+    return rank;
+}
+
+bool LinkGraph::write_tsv(const std::string& dir) const {
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    std::vector<double> rank = pagerank();
+
+    std::ofstream nodes(dir + "/nodes.tsv", std::ios::trunc);
+    nodes << "id\turl\tcrawled\tin_degree\tout_degree\tpagerank\n";
+    for (uint32_t id = 0; id < urls_.size(); ++id) {
+        int32_t row = row_of_[id];
+        uint64_t out = row < 0 ? 0 : row_offsets_[static_cast<size_t>(row) + 1] - row_offsets_[static_cast<size_t>(row)];
+        nodes << id << '\t' << urls_[id] << '\t' << (row >= 0 ? 1 : 0) << '\t' << in_degree_[id] << '\t' << out
+              << '\t' << rank[id] << '\n';
+    }
+
+    std::ofstream edges(dir + "/edges.tsv", std::ios::trunc);
+    edges << "source\ttarget\n";
+    for (size_t r = 0; r < row_node_.size(); ++r)
+        for (uint64_t e = row_offsets_[r]; e < row_offsets_[r + 1]; ++e) edges << row_node_[r] << '\t' << targets_[e] << '\n';
+    return nodes.good() && edges.good();
+}
+
+} // namespace scrapellm
@@ -0,0 +1,118 @@
+#include "scrape_llm/link_scorer.hpp"
+#include "parse/normalizer.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace scrapellm {
+
+// Words that say nothing about which pages hold the data: instruction verbs, JSON schema
+// vocabulary and URL noise.
+static const std::unordered_set<std::string>& stopwords() {
+    static const std::unordered_set<std::string> words = {
+        "the", "and", "for", "with", "from", "into", "that", "this", "these", "those", "are", "was",
+        "were", "has", "have", "its", "their", "per", "each", "every", "all", "any", "not", "only",
+        "extract", "get", "want", "need", "should", "would", "will", "include", "including",
+        "page", "site", "website", "data", "info", "information", "field", "value", "detail",
+        "string", "number", "integer", "boolean", "array", "object", "list", "json", "null", "type",
+        "property", "required", "description", "optional",
+        "http", "https", "www", "html", "htm", "php", "asp", "aspx", "jsp", "index"};
+    return words;
+}
+
+// Path or anchor words typical of navigation, legal and account pages.
+static const std::unordered_set<std::string>& boilerplate() {
+    static const std::unordered_set<std::string> words = {
+        "privacy", "term", "legal", "cookie", "policy", "login", "signin", "signup", "logout",
+        "register", "account", "cart", "checkout", "career", "job", "press", "contact", "about",
+        "blog", "new", "tag", "author", "feed", "rss", "share", "subscribe", "newsletter"};
+    return words;
+}
+
+// "categories" -> "category", "prices" -> "price"; "class", "status" and short words are kept.
+static std::string singular(std::string w) {
+    if (w.size() > 4 && w.compare(w.size() - 3, 3, "ies") == 0) return w.substr(0, w.size() - 3) + "y";
+    if (w.size() > 3 && w.back() == 's' && w[w.size() - 2] != 's' && w[w.size() - 2] != 'u')
+        w.pop_back();
+    return w;
+}
+
+std::vector<std::string> LinkScorer::tokenize(const std::string& text) {
+    std::vector<std::string> out;
+    std::string cur;
+    bool all_digits = true;
+    auto flush = [&] {
+        if (cur.size() >= 3 && !all_digits) {
+            std::string w = singular(cur);
+            if (!stopwords().count(w) && !stopwords().count(cur)) out.push_back(std::move(w));
+        }
+        cur.clear();
+        all_digits = true;
+    };
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (!std::isalnum(c)) {
+            flush();
+            continue;
+        }
+        // camelCase boundary: "unitPrice" -> "unit", "price"
+        if (std::isupper(c) && i > 0 && std::islower(static_cast<unsigned char>(text[i - 1]))) flush();
+        cur += static_cast<char>(std::tolower(c));
+        if (!std::isdigit(c)) all_digits = false;
+    }
+    flush();
+    return out;
+}
+
+static void collect_property_names(const json& schema, std::vector<std::string>& out, int depth) {
+    if (depth > 4 || !schema.is_object()) return;
+    if (schema.contains("properties") && schema["properties"].is_object()) {
+        for (auto it = schema["properties"].begin(); it != schema["properties"].end(); ++it) {
+            out.push_back(it.key());
+            collect_property_names(it.value(), out, depth + 1);
+        }
+    }
+    if (schema.contains("items")) collect_property_names(schema["items"], out, depth + 1);
+}
+
+LinkScorer::LinkScorer(const std::string& schema_description, const InferredSchema& schema) {
+    std::vector<std::string> sources = {schema_description};
+    if (schema.hints.is_object() && schema.hints.contains("key_fields") && schema.hints["key_fields"].is_array()) {
+        for (const auto& f : schema.hints["key_fields"])
+            if (f.is_string()) sources.push_back(f.get<std::string>());
+    }
+    collect_property_names(schema.json_schema, sources, 0);
+    for (const auto& s : sources)
+        for (auto& w : tokenize(s)) keywords_.insert(std::move(w));
+}
+
+int LinkScorer::hits(const std::vector<std::string>& tokens) const {
+    std::unordered_set<std::string> matched;
+    for (const auto& t : tokens)
+        if (keywords_.count(t)) matched.insert(t);
+    return static_cast<int>(matched.size());
+}
+
+double LinkScorer::score(const LinkContext& link) const {
+    if (keywords_.empty()) return 0.0;
+    std::string url_text;
+    if (auto parsed = docscraper::parse::URLNormalizer::parse(link.url))
+        url_text = parsed->path + " " + parsed->query;
+    auto url_tokens = tokenize(url_text);
+    auto anchor_tokens = tokenize(link.anchor);
+
+    double s = 3.0 * hits(anchor_tokens) + 2.0 * hits(url_tokens) + 1.0 * hits(tokenize(link.heading));
+    for (const auto* tokens : {&url_tokens, &anchor_tokens}) {
+        for (const auto& t : *tokens) {
+            if (boilerplate().count(t) && !keywords_.count(t)) return s - 2.0;
+        }
+    }
+    return s;
+}
+
+bool LinkScorer::matches_page(const std::string& text) const {
+    if (keywords_.empty()) return false;
+    int needed = std::clamp(static_cast<int>(keywords_.size() / 3), 1, 3);
+    return hits(tokenize(text)) >= needed;
+}
+
+} // namespace scrapellm
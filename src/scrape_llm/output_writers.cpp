@@ -14,6 +14,17 @@ void write_schema(const std::string& out_dir, const nlohmann::json& schema_obj)
     if (f) f << schema_obj.dump(2);
 }
 
+bool read_schema(const std::string& out_dir, nlohmann::json& schema_obj) {
+    std::ifstream f(out_dir + "/schema.json");
+    if (!f) return false;
+    try {
+        schema_obj = nlohmann::json::parse(f);
+    } catch (...) {
+        return false;
+    }
+    return schema_obj.is_object();
+}
+
 static bool is_flat_record(const nlohmann::json& j) {
     if (!j.is_object()) return false;
     for (auto it = j.begin(); it != j.end(); ++it) {
@@ -0,0 +1,501 @@
+#include "scrape_llm/page_store.hpp"
+#include "utils/hash.hpp"
+#include <zlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kRecordMagic = 0x52505747;  // "GWPR"
+constexpr uint32_t kIndexMagic = 0x49505747;   // "GWPI"
+constexpr uint32_t kIndexVersion = 2;
+constexpr uint32_t kFlagCompressed = 1;
+constexpr uint32_t kFlagTombstone = 2;   // eviction marker: key only, no data
+
+// On-disk record header (host byte order), followed by key bytes then data bytes.
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t key_len;
+    uint32_t data_len;
+    uint32_t raw_len;
+    uint32_t crc;       // crc32 over key + data
+    uint32_t flags;
+};
+
+uint32_t record_crc(const char* key, size_t key_len, const char* data, size_t data_len) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(key), static_cast<uInt>(key_len));
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(data_len));
+    return static_cast<uint32_t>(crc);
+}
+
+bool pread_all(int fd, char* buf, size_t len, uint64_t offset) {
+    while (len > 0) {
+        ssize_t n = ::pread(fd, buf, len, static_cast<off_t>(offset));
+        if (n <= 0) return false;
+        buf += n;
+        len -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+bool write_all(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, buf, len);
+        if (n <= 0) return false;
+        buf += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Build a complete record (header + key + compressed value).
+std::string encode_record(const std::string& key, const std::string& value) {
+    uLongf bound = compressBound(static_cast<uLong>(value.size()));
+    std::string data(bound, '\0');
+    uint32_t flags = kFlagCompressed;
+    if (compress2(reinterpret_cast<Bytef*>(data.data()), &bound,
+                  reinterpret_cast<const Bytef*>(value.data()), static_cast<uLong>(value.size()),
+                  Z_DEFAULT_COMPRESSION) == Z_OK && bound < value.size()) {
+        data.resize(bound);
+    } else {
+        data = value;
+        flags = 0;
+    }
+
+    RecordHeader h{};
+    h.magic = kRecordMagic;
+    h.key_len = static_cast<uint32_t>(key.size());
+    h.data_len = static_cast<uint32_t>(data.size());
+    h.raw_len = static_cast<uint32_t>(value.size());
+    h.crc = record_crc(key.data(), key.size(), data.data(), data.size());
+    h.flags = flags;
+
+    std::string rec(sizeof(h) + key.size() + data.size(), '\0');
+    std::memcpy(rec.data(), &h, sizeof(h));
+    std::memcpy(rec.data() + sizeof(h), key.data(), key.size());
+    std::memcpy(rec.data() + sizeof(h) + key.size(), data.data(), data.size());
+    return rec;
+}
+
+std::string encode_tombstone(const std::string& key) {
+    RecordHeader h{};
+    h.magic = kRecordMagic;
+    h.key_len = static_cast<uint32_t>(key.size());
+    h.crc = record_crc(key.data(), key.size(), key.data() + key.size(), 0);
+    h.flags = kFlagTombstone;
+    std::string rec(sizeof(h) + key.size(), '\0');
+    std::memcpy(rec.data(), &h, sizeof(h));
+    std::memcpy(rec.data() + sizeof(h), key.data(), key.size());
+    return rec;
+}
+
+// Verify a whole record read from disk and return its decoded value for key.
+std::optional<std::string> decode_record(const std::string& rec, const std::string& key) {
+    if (rec.size() < sizeof(RecordHeader)) return std::nullopt;
+    RecordHeader h;
+    std::memcpy(&h, rec.data(), sizeof(h));
+    if (h.magic != kRecordMagic || sizeof(h) + h.key_len + h.data_len != rec.size()) return std::nullopt;
+    const char* k = rec.data() + sizeof(h);
+    const char* d = k + h.key_len;
+    if (std::string_view(k, h.key_len) != key) return std::nullopt;  // fingerprint collision
+    if (record_crc(k, h.key_len, d, h.data_len) != h.crc) return std::nullopt;
+    if (!(h.flags & kFlagCompressed)) return std::string(d, h.data_len);
+    std::string out(h.raw_len, '\0');
+    uLongf out_len = h.raw_len;
+    if (uncompress(reinterpret_cast<Bytef*>(out.data()), &out_len,
+                   reinterpret_cast<const Bytef*>(d), h.data_len) != Z_OK || out_len != h.raw_len)
+        return std::nullopt;
+    return out;
+}
+
+} // namespace
+
+PageStore::PageStore(Options options)
+    : options_(std::move(options))
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_locked();
+}
+
+PageStore::~PageStore() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_locked();
+    for (auto& [id, seg] : segments_)
+        if (seg.fd >= 0) ::close(seg.fd);
+}
+
+std::string PageStore::segment_path(uint32_t id) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "seg-%06u.pack", id);
+    return options_.dir + "/" + name;
+}
+
+std::string PageStore::index_path() const {
+    return options_.dir + "/index.bin";
+}
+
+void PageStore::open_locked() {
+    std::error_code ec;
+    fs::create_directories(options_.dir, ec);
+
+    for (const auto& entry : fs::directory_iterator(options_.dir, ec)) {
+        std::string name = entry.path().filename().string();
+        unsigned id = 0;
+        if (std::sscanf(name.c_str(), "seg-%06u.pack", &id) != 1 || name.size() != 15) continue;
+        int fd = ::open(entry.path().c_str(), O_RDWR | O_APPEND);
+        if (fd < 0) continue;
+        Segment seg;
+        seg.fd = fd;
+        seg.size = static_cast<uint64_t>(::lseek(fd, 0, SEEK_END));
+        segments_[id] = seg;
+    }
+
+    std::map<uint32_t, uint64_t> covered;
+    if (!load_index_locked(covered)) {
+        index_.clear();
+        tombstones_.clear();
+        covered.clear();
+    }
+
+    // Drop snapshot entries whose segment vanished or was truncated.
+    for (auto it = index_.begin(); it != index_.end();) {
+        auto seg = segments_.find(it->second.segment);
+        if (seg == segments_.end() || it->second.offset + it->second.length > seg->second.size)
+            it = index_.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = tombstones_.begin(); it != tombstones_.end();) {
+        auto seg = segments_.find(it->second.segment);
+        if (seg == segments_.end() || it->second.offset + it->second.length > seg->second.size)
+            it = tombstones_.erase(it);
+        else
+            ++it;
+    }
+
+    // Records appended after the last snapshot are recovered by scanning segment tails.
+    for (auto& [id, seg] : segments_) {
+        auto c = covered.find(id);
+        scan_segment_locked(id, c == covered.end() ? 0 : std::min(c->second, seg.size));
+    }
+
+    live_bytes_ = 0;
+    for (auto& [id, seg] : segments_) seg.live = 0;
+    for (const auto& [fp, loc] : index_) {
+        segments_[loc.segment].live += loc.length;
+        live_bytes_ += loc.length;
+    }
+    active_ = segments_.empty() ? 1 : segments_.rbegin()->first;
+}
+
+bool PageStore::load_index_locked(std::map<uint32_t, uint64_t>& covered) {
+    std::ifstream f(index_path(), std::ios::binary);
+    if (!f) return false;
+    auto read = [&f](auto& v) { return static_cast<bool>(f.read(reinterpret_cast<char*>(&v), sizeof(v))); };
+
+    uint32_t magic = 0, version = 0, seg_count = 0;
+    if (!read(magic) || !read(version) || !read(seg_count)) return false;
+    if (magic != kIndexMagic || version != kIndexVersion) return false;
+    for (uint32_t i = 0; i < seg_count; ++i) {
+        uint32_t id = 0;
+        uint64_t len = 0;
+        if (!read(id) || !read(len)) return false;
+        covered[id] = len;
+    }
+    uint64_t count = 0;
+    if (!read(count)) return false;
+    index_.reserve(static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t fp = 0;
+        Location loc;
+        if (!read(fp) || !read(loc.segment) || !read(loc.length) || !read(loc.offset)) return false;
+        index_[fp] = loc;
+    }
+    uint64_t dead = 0;
+    if (!read(dead)) return false;
+    for (uint64_t i = 0; i < dead; ++i) {
+        uint64_t fp = 0;
+        Tombstone t;
+        if (!read(fp) || !read(t.segment) || !read(t.length) || !read(t.offset)) return false;
+        tombstones_[fp] = t;
+    }
+    return true;
+}
+
+void PageStore::scan_segment_locked(uint32_t id, uint64_t from) {
+    Segment& seg = segments_[id];
+    uint64_t pos = from;
+    std::string key;
+    while (pos < seg.size) {
+        RecordHeader h;
+        bool ok = pos + sizeof(h) <= seg.size && pread_all(seg.fd, reinterpret_cast<char*>(&h), sizeof(h), pos) &&
+                  h.magic == kRecordMagic;
+        uint64_t len = ok ? sizeof(h) + uint64_t(h.key_len) + h.data_len : 0;
+        std::string rec;
+        if (ok && pos + len <= seg.size) {
+            rec.resize(len);
+            ok = pread_all(seg.fd, rec.data(), len, pos);
+        } else {
+            ok = false;
+        }
+        if (ok) {
+            const char* k = rec.data() + sizeof(h);
+            ok = record_crc(k, h.key_len, k + h.key_len, h.data_len) == h.crc;
+            if (ok) key.assign(k, h.key_len);
+        }
+        if (!ok) {
+            // Torn or corrupt tail from an interrupted append: cut it off.
+            if (::ftruncate(seg.fd, static_cast<off_t>(pos)) == 0) seg.size = pos;
+            dirty_ = true;
+            return;
+        }
+        uint64_t fp = docscraper::utils::fingerprint64(key);
+        if (h.flags & kFlagTombstone) {
+            // An evicted page: forget any earlier record of it so a rescan does not resurrect it.
+            index_.erase(fp);
+            tombstones_[fp] = Tombstone{id, static_cast<uint32_t>(len), pos};
+        } else {
+            index_[fp] = Location{id, static_cast<uint32_t>(len), pos, 0};
+            tombstones_.erase(fp);
+        }
+        dirty_ = true;
+        pos += len;
+    }
+}
+
+bool PageStore::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flush_locked();
+}
+
+bool PageStore::flush_locked() {
+    if (!dirty_) return true;
+    std::string tmp = index_path() + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) return false;
+        auto write = [&f](const auto& v) { f.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+        write(kIndexMagic);
+        write(kIndexVersion);
+        write(static_cast<uint32_t>(segments_.size()));
+        for (const auto& [id, seg] : segments_) {
+            write(id);
+            write(seg.size);
+        }
+        write(static_cast<uint64_t>(index_.size()));
+        for (const auto& [fp, loc] : index_) {
+            write(fp);
+            write(loc.segment);
+            write(loc.length);
+            write(loc.offset);
+        }
+        write(static_cast<uint64_t>(tombstones_.size()));
+        for (const auto& [fp, t] : tombstones_) {
+            write(fp);
+            write(t.segment);
+            write(t.length);
+            write(t.offset);
+        }
+        if (!f) return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, index_path(), ec);
+    if (ec) return false;
+    dirty_ = false;
+    return true;
+}
+
+bool PageStore::contains(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.count(docscraper::utils::fingerprint64(key)) > 0;
+}
+
+std::optional<std::string> PageStore::get(const std::string& key) {
+    uint64_t fp = docscraper::utils::fingerprint64(key);
+    std::string rec;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(fp);
+        if (it == index_.end()) return std::nullopt;
+        it->second.last_access = ++clock_;
+        const Location& loc = it->second;
+        rec.resize(loc.length);
+        if (!pread_all(segments_[loc.segment].fd, rec.data(), loc.length, loc.offset)) return std::nullopt;
+    }
+    return decode_record(rec, key);  // decompress outside the lock
+}
+
+bool PageStore::put(const std::string& key, const std::string& value) {
+    std::string rec = encode_record(key, value);  // compress outside the lock
+    uint64_t fp = docscraper::utils::fingerprint64(key);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!append_locked(fp, rec)) return false;
+    if (options_.max_bytes > 0 && live_bytes_ > options_.max_bytes) {
+        evict_locked();
+        compact_locked();
+    }
+    return true;
+}
+
+PageStore::Segment& PageStore::active_segment_locked(uint64_t next_record) {
+    auto it = segments_.find(active_);
+    if (it != segments_.end() && (it->second.size == 0 || it->second.size + next_record <= options_.segment_bytes))
+        return it->second;
+    if (it != segments_.end()) ++active_;
+    Segment seg;
+    seg.fd = ::open(segment_path(active_).c_str(), O_RDWR | O_APPEND | O_CREAT | O_TRUNC, 0644);
+    return segments_[active_] = seg;
+}
+
+bool PageStore::append_locked(uint64_t fp, const std::string& record) {
+    Segment& seg = active_segment_locked(record.size());
+    if (seg.fd < 0) return false;
+    uint64_t offset = seg.size;
+    if (!write_all(seg.fd, record.data(), record.size())) {
+        if (::ftruncate(seg.fd, static_cast<off_t>(offset)) != 0) {
+            // Leave the torn tail for the CRC scan on next open.
+        }
+        return false;
+    }
+    seg.size += record.size();
+    drop_locked(fp);
+    tombstones_.erase(fp);
+    index_[fp] = Location{active_, static_cast<uint32_t>(record.size()), offset, ++clock_};
+    seg.live += record.size();
+    live_bytes_ += record.size();
+    dirty_ = true;
+    return true;
+}
+
+void PageStore::drop_locked(uint64_t fp) {
+    auto it = index_.find(fp);
+    if (it == index_.end()) return;
+    segments_[it->second.segment].live -= it->second.length;
+    live_bytes_ -= it->second.length;
+    index_.erase(it);
+    dirty_ = true;
+}
+
+void PageStore::evict_locked() {
+    // Evict least-recently-used pages down to 90% of the budget so eviction runs in batches.
+    uint64_t target = options_.max_bytes / 10 * 9;
+    std::vector<std::pair<uint64_t, uint64_t>> by_age;  // (last_access, fp)
+    by_age.reserve(index_.size());
+    for (const auto& [fp, loc] : index_) by_age.emplace_back(loc.last_access, fp);
+    std::sort(by_age.begin(), by_age.end());
+    for (const auto& [age, fp] : by_age) {
+        if (live_bytes_ <= target) break;
+        const Location loc = index_[fp];
+        std::string key = read_key_locked(loc.segment, loc.offset);
+        drop_locked(fp);
+        if (!key.empty()) append_tombstone_locked(fp, encode_tombstone(key));
+    }
+}
+
+std::string PageStore::read_key_locked(uint32_t segment, uint64_t offset) {
+    RecordHeader h;
+    int fd = segments_[segment].fd;
+    if (!pread_all(fd, reinterpret_cast<char*>(&h), sizeof(h), offset) || h.magic != kRecordMagic) return {};
+    std::string key(h.key_len, '\0');
+    if (!pread_all(fd, key.data(), key.size(), offset + sizeof(h))) return {};
+    return key;
+}
+
+bool PageStore::append_tombstone_locked(uint64_t fp, const std::string& record) {
+    Segment& seg = active_segment_locked(record.size());
+    if (seg.fd < 0) return false;
+    uint64_t offset = seg.size;
+    if (!write_all(seg.fd, record.data(), record.size())) {
+        if (::ftruncate(seg.fd, static_cast<off_t>(offset)) != 0) {
+            // Leave the torn tail for the CRC scan on next open.
+        }
+        return false;
+    }
+    seg.size += record.size();
+    tombstones_[fp] = Tombstone{active_, static_cast<uint32_t>(record.size()), offset};
+    dirty_ = true;
+    return true;
+}
+
+void PageStore::compact_locked() {
+    // Rewrite sealed segments that are less than half live into the active segment.
+    std::vector<uint32_t> victims;
+    for (const auto& [id, seg] : segments_)
+        if (id != active_ && seg.live * 2 < seg.size) victims.push_back(id);
+    if (victims.empty()) return;
+
+    std::vector<uint32_t> kept;  // victims whose tombstones could not be carried over
+    for (uint32_t id : victims) {
+        int fd = segments_[id].fd;
+        std::vector<std::pair<uint64_t, Location>> moving;
+        for (const auto& [fp, loc] : index_)
+            if (loc.segment == id) moving.emplace_back(fp, loc);
+        for (const auto& [fp, loc] : moving) {
+            std::string rec(loc.length, '\0');
+            if (!pread_all(fd, rec.data(), loc.length, loc.offset)) {
+                drop_locked(fp);
+                continue;
+            }
+            uint64_t access = loc.last_access;
+            if (append_locked(fp, rec)) index_[fp].last_access = access;
+        }
+
+        // A tombstone must outlive every older segment that may still hold the page it shadows.
+        bool older_survives = false;
+        for (const auto& [other, seg] : segments_)
+            if (other < id && std::find(victims.begin(), victims.end(), other) == victims.end())
+                older_survives = true;
+        std::vector<std::pair<uint64_t, Tombstone>> dead;
+        for (const auto& [fp, t] : tombstones_)
+            if (t.segment == id) dead.emplace_back(fp, t);
+        for (const auto& [fp, t] : dead) {
+            if (!older_survives) {
+                tombstones_.erase(fp);
+                continue;
+            }
+            std::string rec(t.length, '\0');
+            if (!pread_all(fd, rec.data(), t.length, t.offset) || !append_tombstone_locked(fp, rec)) {
+                kept.push_back(id);
+                break;
+            }
+        }
+    }
+    // Persist the new locations before deleting the old segments.
+    if (!flush_locked()) return;
+    for (uint32_t id : victims) {
+        auto it = segments_.find(id);
+        if (it == segments_.end() || it->second.live != 0) continue;
+        if (std::find(kept.begin(), kept.end(), id) != kept.end()) continue;
+        ::close(it->second.fd);
+        std::error_code ec;
+        fs::remove(segment_path(id), ec);
+        segments_.erase(it);
+    }
+    dirty_ = true;
+    flush_locked();
+}
+
+PageStore::Stats PageStore::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s;
+    s.entries = index_.size();
+    s.live_bytes = live_bytes_;
+    s.segments = segments_.size();
+    for (const auto& [id, seg] : segments_) s.file_bytes += seg.size;
+    return s;
+}
+
+} // namespace scrapellm
@@ -0,0 +1,121 @@
+#include "scrape_llm/pagination.hpp"
+#include "parse/normalizer.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <sstream>
+
+namespace scrapellm {
+
+namespace {
+
+constexpr std::array<const char*, 7> kPageKeys = {"page", "p", "pg", "paged", "pagenum", "page_num", "pageno"};
+
+std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// Pages past this are not numbers but ids or years.
+int parse_page(const std::string& s) {
+    if (s.empty() || s.size() > 4 || !std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); }))
+        return -1;
+    return std::stoi(s);
+}
+
+// A listing URL split into its page number and everything else.
+struct PageRef {
+    std::string listing;  // origin, path and query without the page marker
+    std::string path;     // origin and path without a "/page/N" suffix
+    int number = -1;
+};
+
+PageRef page_ref(const std::string& url) {
+    PageRef ref;
+    auto parsed = docscraper::parse::URLNormalizer::parse(docscraper::parse::URLNormalizer::normalize(url, false));
+    if (!parsed) return ref;
+
+    std::string origin = parsed->scheme + "://" + parsed->host;
+    if (parsed->port > 0 && !parsed->is_default_port()) origin += ":" + std::to_string(parsed->port);
+
+    std::vector<std::string> segments;
+    std::istringstream path_stream(parsed->path);
+    for (std::string seg; std::getline(path_stream, seg, '/');)
+        if (!seg.empty()) segments.push_back(seg);
+    if (segments.size() >= 2 && lower(segments[segments.size() - 2]) == "page") {
+        int n = parse_page(segments.back());
+        if (n >= 0) {
+            ref.number = n;
+            segments.resize(segments.size() - 2);
+        }
+    }
+    ref.path = origin + "/";
+    for (size_t i = 0; i < segments.size(); ++i) ref.path += (i ? "/" : "") + segments[i];
+
+    std::string query;
+    std::istringstream query_stream(parsed->query);
+    for (std::string param; std::getline(query_stream, param, '&');) {
+        if (param.empty()) continue;
+        size_t eq = param.find('=');
+        std::string key = lower(param.substr(0, eq));
+        if (ref.number < 0 && eq != std::string::npos &&
+            std::find(kPageKeys.begin(), kPageKeys.end(), key) != kPageKeys.end()) {
+            int n = parse_page(param.substr(eq + 1));
+            if (n >= 0) {
+                ref.number = n;
+                continue;
+            }
+        }
+        query += (query.empty() ? "" : "&") + param;
+    }
+    ref.listing = ref.path + (query.empty() ? "" : "?" + query);
+    return ref;
+}
+
+bool has_rel_next(const std::string& rel) {
+    std::istringstream tokens(lower(rel));
+    for (std::string t; tokens >> t;)
+        if (t == "next") return true;
+    return false;
+}
+
+bool reads_next(const std::string& anchor) {
+    std::string a = lower(anchor);
+    for (const char* arrow : {"»", "›", "→", ">>", ">"}) {
+        size_t pos;
+        while ((pos = a.find(arrow)) != std::string::npos) a.erase(pos, std::char_traits<char>::length(arrow));
+    }
+    a.erase(0, a.find_first_not_of(" \t"));
+    a.erase(a.find_last_not_of(" \t.") + 1);
+    // A bare arrow is a "next" button; "»»" and "last" usually jump to the end instead.
+    if (a.empty()) return lower(anchor) != "»»" && !anchor.empty();
+    return a == "next" || a == "next page" || a == "older posts" || a == "older entries" || a == "more results";
+}
+
+} // namespace
+
+int url_page_number(const std::string& url) {
+    return page_ref(url).number;
+}
+
+bool is_pagination_link(const LinkContext& link, const std::string& page_url) {
+    if (has_rel_next(link.rel)) return true;
+    PageRef page = page_ref(page_url);
+    PageRef target = page_ref(link.url);
+    int current = std::max(page.number, 1);
+    // A numbered page of a different listing (another sort order or filter) is not followed.
+    if (target.number >= 0) return target.listing == page.listing && target.number > current;
+    if (target.path != page.path) return false;
+    if (reads_next(link.anchor)) return true;
+    int n = parse_page(link.anchor);
+    return n > current;
+}
+
+bool canonical_applies(const std::string& canonical, const std::string& page_url, int pagination) {
+    if (pagination > 0) return false;
+    PageRef page = page_ref(page_url);
+    PageRef target = page_ref(canonical);
+    return target.listing != page.listing || std::max(target.number, 1) == std::max(page.number, 1);
+}
+
+} // namespace scrapellm
@@ -1,5 +1,9 @@
 #include "scrape_llm/pipeline.hpp"
+#include "scrape_llm/checkpoint.hpp"
 #include "scrape_llm/crawl_fetcher.hpp"
+#include "scrape_llm/crawler.hpp"
+#include "scrape_llm/incremental_store.hpp"
+#include "scrape_llm/link_classifier.hpp"
 #include "scrape_llm/content_extractor.hpp"
 #include "scrape_llm/schema_infer.hpp"
 #include "scrape_llm/relevance_router.hpp"
@@ -8,11 +12,12 @@
 #include "scrape_llm/output_writers.hpp"
 #include "scrape_llm/report_generator.hpp"
 #include "scrape_llm/ssrf_guard.hpp"
-#include "parse/html_parser.hpp"
 #include "parse/normalizer.hpp"
+#include "utils/hash.hpp"
+#include "utils/simhash.hpp"
 #include <spdlog/spdlog.h>
-#include <queue>
 #include <chrono>
+#include <map>
 #include <set>
 #include <algorithm>
 #include <nlohmann/json.hpp>
@@ -31,6 +36,13 @@ static std::string stable_json_hash(const nlohmann::json& j) {
     return nlohmann::json(j).dump();
 }
 
+// Records reused by --incremental, and the link model's decisions, are only valid for the same
+// request, schema and model.
+static std::string schema_key(const RunConfig& config, const InferredSchema& schema) {
+    std::string data = config.schema + '\n' + schema.json_schema.dump() + '\n' + schema.extraction_mode + '\n' + config.model;
+    return std::to_string(docscraper::utils::fingerprint64(data));
+}
+
 int run_pipeline(const RunConfig& config) {
     RunReport report;
 
@@ -59,113 +71,187 @@ int run_pipeline(const RunConfig& config) {
         return 1;
     }
 
+    // The schema a resumed run's checkpoint was built with is the one in out/schema.json.
     InferredSchema schema;
-    std::string schema_warning;
-    schema = schema_infer(llm, config.schema, schema_warning);
-    if (!schema_warning.empty()) spdlog::warn("{}", schema_warning);
+    nlohmann::json saved_schema;
+    bool have_schema = false;
+    if (config.resume && read_schema(config.out_dir, saved_schema) && saved_schema.contains("json_schema")) {
+        schema.json_schema = saved_schema["json_schema"];
+        schema.extraction_mode = saved_schema.value("extraction_mode", "list");
+        schema.hints = saved_schema.value("hints", nlohmann::json::object());
+        have_schema = true;
+    }
+    if (!have_schema) {
+        std::string schema_warning;
+        schema = schema_infer(llm, config.schema, schema_warning);
+        if (!schema_warning.empty()) spdlog::warn("{}", schema_warning);
 
-    nlohmann::json schema_to_save = {{"json_schema", schema.json_schema}, {"extraction_mode", schema.extraction_mode}, {"hints", schema.hints}};
-    write_schema(config.out_dir, schema_to_save);
+        nlohmann::json schema_to_save = {{"json_schema", schema.json_schema}, {"extraction_mode", schema.extraction_mode}, {"hints", schema.hints}};
+        write_schema(config.out_dir, schema_to_save);
+    }
 
     CrawlFetcher fetcher(config);
-    if (config.respect_robots)
+    if (config.respect_robots || config.seed_from_sitemaps)
         fetcher.fetch_robots(config.url);
 
-    struct QueuedUrl { std::string url; int depth; };
-    std::queue<QueuedUrl> queue;
-    queue.push({config.url, 0});
-    std::set<std::string> queued;
-    queued.insert(docscraper::parse::URLNormalizer::normalize(config.url, false));
-
-    auto t_crawl_start = std::chrono::steady_clock::now();
-    std::vector<CrawlResult> crawled;
-    std::vector<std::string> all_html;
-    std::vector<std::string> all_urls;
-
-    while (!queue.empty() && static_cast<int>(crawled.size()) < config.max_pages) {
-        QueuedUrl qu = queue.front();
-        queue.pop();
-        auto res = fetcher.fetch(qu.url, qu.depth);
-        if (!res) continue;
-        if (!res->success) {
-            report.errors.push_back(res->url + ": " + res->error);
-            continue;
-        }
-        if (config.respect_robots && !fetcher.is_allowed_by_robots(res->url))
-            continue;
-
-        report.pages_visited.push_back(res->url);
-        report.pages_crawled++;
-        crawled.push_back(*res);
-        all_html.push_back(res->html);
-        all_urls.push_back(res->final_url);
-
-        if (qu.depth >= config.max_depth) continue;
-        docscraper::parse::HTMLDocument doc(res->html);
-        auto links = extract_links_absolute(doc, res->final_url);
-        for (const auto& link : links) {
-            if (extract_origin(link) != base_origin) continue;
-            std::string norm = docscraper::parse::URLNormalizer::normalize(link, false);
-            if (!url_allowed_ssrf(norm, config.allow_private_network)) continue;
-            if (queued.count(norm)) continue;
-            queued.insert(norm);
-            queue.push({link, qu.depth + 1});
-        }
+    // Trained on earlier runs' relevance decisions; learns from this run's below.
+    LinkClassifier link_model(config.out_dir, schema_key(config, schema));
+    if (config.link_model) {
+        int64_t examples = link_model.load();
+        if (examples > 0)
+            spdlog::info("Link model: trained on {} page(s){}", examples, link_model.ready() ? "" : " (too few to use yet)");
     }
 
-    report.crawl_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t_crawl_start);
+    Checkpoint checkpoint(config);
+    Crawler crawler(config, fetcher, LinkScorer(config.schema, schema), &checkpoint);
+    if (config.link_model) crawler.set_link_classifier(&link_model);
+    // List records usually span a listing's pages; single-record schemas are not paginated.
+    crawler.set_follow_pagination(schema.extraction_mode == "list");
+    bool resumed = have_schema && crawler.restore(report);
+    if (config.resume && !resumed) spdlog::warn("No checkpoint to resume in {}; starting a fresh run", checkpoint.dir());
+    if (!resumed) checkpoint.reset();
+    std::vector<CrawlResult> crawled = crawler.run(report);
+    fetcher.flush_cache();
+    // PageRank over the crawl's links orders the pages the LLM keeps (see select_pages_to_parse).
+    const LinkGraph& graph = crawler.graph();
+    std::vector<double> ranks = graph.pagerank();
+    if (config.export_graph) {
+        if (graph.write_tsv(config.out_dir + "/graph"))
+            spdlog::info("Link graph: {} URLs, {} links written to {}/graph", graph.nodes(), graph.edges(), config.out_dir);
+        else
+            spdlog::warn("Link graph: could not write {}/graph", config.out_dir);
+    }
+    // Pages whose text nearly matches an earlier page (sort orders, tracking parameters, print
+    // views) stop here; only the first of each cluster goes to the LLM stages. The crawler parsed
+    // every page once into its content; the HTML is gone.
+    std::vector<ExtractedContent> pages;
+    docscraper::utils::SimHashIndex near_dups(config.near_dup_distance);
+    for (size_t i = 0; i < crawled.size(); ++i) {
+        auto& page = crawled[i];
+        if (config.near_dup_distance >= 0 && page.simhash != 0) {
+            if (auto first = near_dups.find(page.simhash)) {
+                report.duplicates.push_back({page.final_url, crawled[*first].final_url});
+                continue;
+            }
+            near_dups.insert(page.simhash, i);
+        }
+        pages.push_back(std::move(page.content));
+    }
+    crawled.clear();
+    crawled.shrink_to_fit();
+    if (!report.duplicates.empty())
+        spdlog::info("Skipping {} near-duplicate page(s)", report.duplicates.size());
 
     if (config.dry_run) {
         report.llm_ms = std::chrono::milliseconds(0);
         write_report(config.out_dir, report);
+        checkpoint.reset();
         spdlog::info("Dry run: crawled {} pages", report.pages_crawled);
         return 0;
     }
 
+    // With --incremental, a page whose extracted content is unchanged since the last run keeps
+    // that run's relevance decision and records; only new and changed pages reach the LLM.
+    IncrementalStore store(config.out_dir, schema_key(config, schema));
+    if (config.incremental) spdlog::info("Incremental: {} page(s) known from the last run", store.load());
+
     std::vector<PageDigest> digests;
-    for (size_t i = 0; i < all_urls.size(); ++i) {
-        docscraper::parse::HTMLDocument doc(all_html[i]);
-        ExtractedContent content = extract_content(doc, all_urls[i]);
-        digests.push_back(make_digest(content, 1500));
+    std::map<std::string, std::string> titles;           // url -> page title, for the link model
+    std::map<std::string, std::string> content_hashes;  // url -> IncrementalStore::content_hash
+    std::map<std::string, ParsedPage> results;           // url -> records of kept pages
+    for (const auto& content : pages) {
+        if (config.incremental) {
+            std::string hash = IncrementalStore::content_hash(content);
+            const IncrementalStore::Entry* prev = store.unchanged(content.url, hash);
+            if (prev && (!prev->decision.keep || prev->parsed)) {
+                if (prev->parsed) results.emplace(content.url, prev->page);
+                report.pages_reused++;
+                continue;
+            }
+            content_hashes[content.url] = std::move(hash);
+        }
+        if (config.link_model) titles[content.url] = content.title;
+        PageDigest digest = make_digest(content, 1500);
+        if (auto id = graph.find(content.url)) digest.rank = ranks[*id];
+        digests.push_back(std::move(digest));
     }
+    if (config.incremental)
+        spdlog::info("Incremental: {} page(s) unchanged, {} new or changed", report.pages_reused, digests.size());
+    size_t reused_kept = results.size();
 
-    std::vector<PageDigest> to_parse = select_pages_to_parse(llm, config.schema, digests, config.keep_pages);
-    report.pages_kept = static_cast<int>(to_parse.size());
+    // Relevance decisions and parsed pages are memoized in the checkpoint as they complete, so a
+    // resumed run only sends the LLM pages it had not finished.
+    RelevanceMemo relevance_memo{
+        [&](const std::string& url) -> const RelevanceDecision* {
+            if (const RelevanceDecision* d = checkpoint.relevance(url)) return d;
+            if (!config.incremental) return nullptr;
+            // Kept last time but not parsed (beyond --keep-pages): the decision still holds.
+            const IncrementalStore::Entry* prev = store.unchanged(url, content_hashes[url]);
+            return prev ? &prev->decision : nullptr;
+        },
+        [&](const std::string& url, const RelevanceDecision& d) {
+            checkpoint.record_relevance(url, d);
+            if (config.incremental) store.record_relevance(url, content_hashes[url], d);
+            if (config.link_model) link_model.update(url, titles[url], d.keep);
+        }};
+    std::vector<PageDigest> to_parse = select_pages_to_parse(llm, config.schema, digests, config.keep_pages, &relevance_memo);
+    if (config.link_model) link_model.save();
+    report.pages_kept = static_cast<int>(to_parse.size() + reused_kept);
 
-    std::vector<nlohmann::json> all_records;
     auto t_llm_start = std::chrono::steady_clock::now();
 
     for (const auto& d : to_parse) {
         size_t idx = 0;
-        for (; idx < all_urls.size(); ++idx) if (all_urls[idx] == d.url) break;
-        if (idx >= all_urls.size()) continue;
-        docscraper::parse::HTMLDocument doc(all_html[idx]);
-        ExtractedContent content = extract_content(doc, all_urls[idx]);
-        auto records = parse_records(llm, schema, content);
-        for (auto& rec : records) {
-            ValidationResult vr = validate_record(rec, schema.json_schema);
-            if (vr.valid) {
-                all_records.push_back(std::move(rec));
-                continue;
-            }
-            report.validation_failures++;
-            report.repair_attempts++;
-            auto repaired = repair_record(llm, rec, schema.json_schema, vr.error_message);
-            if (repaired) {
-                ValidationResult vr2 = validate_record(*repaired, schema.json_schema);
-                if (vr2.valid) {
-                    report.repair_successes++;
-                    all_records.push_back(std::move(*repaired));
+        for (; idx < pages.size(); ++idx) if (pages[idx].url == d.url) break;
+        if (idx >= pages.size()) continue;
+
+        ParsedPage page;
+        if (const ParsedPage* done = checkpoint.parsed(d.url)) {
+            page = *done;
+        } else {
+            auto records = parse_records(llm, schema, pages[idx]);
+            for (auto& rec : records) {
+                ValidationResult vr = validate_record(rec, schema.json_schema);
+                if (vr.valid) {
+                    page.records.push_back(std::move(rec));
+                    continue;
+                }
+                page.validation_failures++;
+                page.repair_attempts++;
+                auto repaired = repair_record(llm, rec, schema.json_schema, vr.error_message);
+                if (repaired) {
+                    ValidationResult vr2 = validate_record(*repaired, schema.json_schema);
+                    if (vr2.valid) {
+                        page.repair_successes++;
+                        page.records.push_back(std::move(*repaired));
+                    } else {
+                        page.errors.push_back("Repair still invalid: " + vr.error_message);
+                    }
                 } else {
-                    report.errors.push_back("Repair still invalid: " + vr.error_message);
+                    page.errors.push_back("Repair failed: " + vr.error_message);
                 }
-            } else {
-                report.errors.push_back("Repair failed: " + vr.error_message);
             }
+            checkpoint.record_parsed(d.url, page);
         }
+        if (config.incremental) store.record_parsed(d.url, content_hashes[d.url], page);
+
+        report.validation_failures += page.validation_failures;
+        report.repair_attempts += page.repair_attempts;
+        report.repair_successes += page.repair_successes;
+        report.errors.insert(report.errors.end(), page.errors.begin(), page.errors.end());
+        results[d.url] = std::move(page);
     }
 
     report.llm_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t_llm_start);
+    if (config.incremental) store.save();
+
+    // Records in crawl order, whether reused or parsed now.
+    std::vector<nlohmann::json> all_records;
+    for (const auto& content : pages) {
+        auto it = results.find(content.url);
+        if (it == results.end()) continue;
+        for (auto& rec : it->second.records) all_records.push_back(std::move(rec));
+    }
 
     std::set<std::string> seen_hashes;
     std::vector<nlohmann::json> deduped;
@@ -190,6 +276,7 @@ int run_pipeline(const RunConfig& config) {
     report.records_emitted = static_cast<int>(deduped.size());
     write_outputs(config.out_dir, config.format, config.emit_csv, deduped);
     write_report(config.out_dir, report);
+    checkpoint.reset();
 
     spdlog::info("Done: {} pages crawled, {} kept, {} records", report.pages_crawled, report.pages_kept, report.records_emitted);
     return 0;
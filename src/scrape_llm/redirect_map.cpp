@@ -0,0 +1,74 @@
+#include "scrape_llm/redirect_map.hpp"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+RedirectMap::RedirectMap(std::string path)
+    : path_(std::move(path))
+{
+    std::ifstream f(path_);
+    if (!f) return;
+    try {
+        auto j = nlohmann::json::parse(f);
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            if (it.value().is_string()) targets_[it.key()] = it.value().get<std::string>();
+        }
+    } catch (...) {
+        targets_.clear();  // corrupt file: redirects are rediscovered by fetching
+    }
+}
+
+void RedirectMap::record(const std::string& from, const std::string& to) {
+    if (from == to || from.empty() || to.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = targets_.try_emplace(from, to);
+    if (!inserted) {
+        if (it->second == to) return;
+        it->second = to;
+    }
+    dirty_ = true;
+}
+
+std::string RedirectMap::resolve(const std::string& normalized_url) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string url = normalized_url;
+    std::set<std::string> visited{url};
+    for (int hop = 0; hop < kMaxHops; ++hop) {
+        auto it = targets_.find(url);
+        if (it == targets_.end() || !visited.insert(it->second).second) break;
+        url = it->second;
+    }
+    return url;
+}
+
+size_t RedirectMap::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return targets_.size();
+}
+
+bool RedirectMap::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dirty_) return true;
+    nlohmann::json j = nlohmann::json::object();
+    for (const auto& [from, to] : targets_) j[from] = to;
+    std::error_code ec;
+    fs::create_directories(fs::path(path_).parent_path(), ec);
+    std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream f(tmp);
+        if (!f) return false;
+        f << j.dump(2);
+        if (!f) return false;
+    }
+    fs::rename(tmp, path_, ec);
+    if (ec) return false;
+    dirty_ = false;
+    return true;
+}
+
+} // namespace scrapellm
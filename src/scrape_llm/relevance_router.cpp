@@ -1,4 +1,5 @@
 #include "scrape_llm/relevance_router.hpp"
+#include <algorithm>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
@@ -28,6 +29,7 @@ RelevanceDecision relevance_decide(ILlmClient& client, const std::string& user_s
     if (!resp) {
         out.keep = false;
         out.reason = "LLM call failed";
+        out.llm_failed = true;
         return out;
     }
     std::string raw = *resp;
@@ -51,17 +53,19 @@ RelevanceDecision relevance_decide(ILlmClient& client, const std::string& user_s
 }
 
 std::vector<PageDigest> select_pages_to_parse(ILlmClient& client, const std::string& user_schema,
-                                               std::vector<PageDigest> digests, int keep_n) {
+                                               std::vector<PageDigest> digests, int keep_n, const RelevanceMemo* memo) {
     std::vector<std::pair<PageDigest, bool>> scored;
     for (auto& d : digests) {
-        RelevanceDecision dec = relevance_decide(client, user_schema, d);
+        const RelevanceDecision* known = memo && memo->lookup ? memo->lookup(d.url) : nullptr;
+        RelevanceDecision dec = known ? *known : relevance_decide(client, user_schema, d);
+        if (!known && !dec.llm_failed && memo && memo->record) memo->record(d.url, dec);
         scored.emplace_back(std::move(d), dec.keep);
     }
     std::vector<PageDigest> out;
-    for (auto& p : scored) {
+    for (auto& p : scored)
         if (p.second) out.push_back(std::move(p.first));
-        if (static_cast<int>(out.size()) >= keep_n) break;
-    }
+    // Past keep_n, better linked pages win; equal ranks keep crawl order.
+    std::stable_sort(out.begin(), out.end(), [](const PageDigest& a, const PageDigest& b) { return a.rank > b.rank; });
     out.resize(std::min(static_cast<int>(out.size()), keep_n));
     return out;
 }
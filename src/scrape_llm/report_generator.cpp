@@ -1,4 +1,5 @@
 #include "scrape_llm/report_generator.hpp"
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
 #include <nlohmann/json.hpp>
@@ -7,12 +8,16 @@ namespace scrapellm {
 
 namespace fs = std::filesystem;
 
-void write_report(const std::string& out_dir, const RunReport& report) {
-    fs::create_directories(out_dir);
-
+nlohmann::json report_to_json(const RunReport& report) {
     nlohmann::json j;
     j["pages_crawled"] = report.pages_crawled;
+    j["pagination_pages"] = report.pagination_pages;
+    j["links_predicted_skip"] = report.links_predicted_skip;
+    j["links_boosted"] = report.links_boosted;
+    j["graph_urls"] = report.graph_urls;
+    j["graph_links"] = report.graph_links;
     j["pages_kept"] = report.pages_kept;
+    j["pages_reused"] = report.pages_reused;
     j["records_emitted"] = report.records_emitted;
     j["validation_failures"] = report.validation_failures;
     j["repair_attempts"] = report.repair_attempts;
@@ -22,15 +27,107 @@ void write_report(const std::string& out_dir, const RunReport& report) {
     j["llm_ms"] = report.llm_ms.count();
     j["errors"] = report.errors;
     j["pages_visited"] = report.pages_visited;
+    nlohmann::json duplicates = nlohmann::json::array();
+    for (const auto& d : report.duplicates) duplicates.push_back({{"url", d.url}, {"duplicate_of", d.duplicate_of}});
+    j["duplicates"] = duplicates;
+    j["aliases"] = report.aliases;
+    nlohmann::json transfer = nlohmann::json::object();
+    for (const auto& [host, s] : report.transfer_by_host) {
+        transfer[host] = {{"pages", s.pages}, {"wire_bytes", s.wire_bytes}, {"decoded_bytes", s.decoded_bytes}};
+    }
+    j["transfer_by_host"] = transfer;
+    nlohmann::json templates = nlohmann::json::object();
+    for (const auto& [tpl, s] : report.templates) {
+        templates[tpl] = {{"queued", s.queued}, {"fetched", s.fetched}, {"on_topic", s.on_topic}, {"skipped", s.skipped}};
+    }
+    j["templates"] = templates;
+    return j;
+}
+
+RunReport report_from_json(const nlohmann::json& j) {
+    RunReport r;
+    if (!j.is_object()) return r;
+    r.pages_crawled = j.value("pages_crawled", 0);
+    r.pagination_pages = j.value("pagination_pages", 0);
+    r.links_predicted_skip = j.value("links_predicted_skip", 0);
+    r.links_boosted = j.value("links_boosted", 0);
+    r.graph_urls = j.value("graph_urls", static_cast<int64_t>(0));
+    r.graph_links = j.value("graph_links", static_cast<int64_t>(0));
+    r.pages_kept = j.value("pages_kept", 0);
+    r.pages_reused = j.value("pages_reused", 0);
+    r.records_emitted = j.value("records_emitted", 0);
+    r.validation_failures = j.value("validation_failures", 0);
+    r.repair_attempts = j.value("repair_attempts", 0);
+    r.repair_successes = j.value("repair_successes", 0);
+    r.tokens_estimate = j.value("tokens_estimate", static_cast<int64_t>(0));
+    r.crawl_ms = std::chrono::milliseconds(j.value("crawl_ms", static_cast<int64_t>(0)));
+    r.llm_ms = std::chrono::milliseconds(j.value("llm_ms", static_cast<int64_t>(0)));
+    r.errors = j.value("errors", std::vector<std::string>{});
+    r.pages_visited = j.value("pages_visited", std::vector<std::string>{});
+    if (j.contains("duplicates") && j["duplicates"].is_array()) {
+        for (const auto& d : j["duplicates"])
+            r.duplicates.push_back({d.value("url", ""), d.value("duplicate_of", "")});
+    }
+    if (j.contains("aliases") && j["aliases"].is_object()) {
+        for (auto it = j["aliases"].begin(); it != j["aliases"].end(); ++it)
+            if (it.value().is_array()) r.aliases[it.key()] = it.value().get<std::vector<std::string>>();
+    }
+    if (j.contains("transfer_by_host") && j["transfer_by_host"].is_object()) {
+        for (auto it = j["transfer_by_host"].begin(); it != j["transfer_by_host"].end(); ++it) {
+            const auto& s = it.value();
+            r.transfer_by_host[it.key()] = HostTransferStats{s.value("pages", 0), s.value("wire_bytes", static_cast<int64_t>(0)),
+                                                             s.value("decoded_bytes", static_cast<int64_t>(0))};
+        }
+    }
+    if (j.contains("templates") && j["templates"].is_object()) {
+        for (auto it = j["templates"].begin(); it != j["templates"].end(); ++it) {
+            const auto& s = it.value();
+            r.templates[it.key()] = TemplateStats{s.value("queued", 0), s.value("fetched", 0), s.value("on_topic", 0),
+                                                  s.value("skipped", 0)};
+        }
+    }
+    return r;
+}
+
+nlohmann::json parsed_page_to_json(const ParsedPage& page) {
+    return {{"records", page.records},
+            {"validation_failures", page.validation_failures},
+            {"repair_attempts", page.repair_attempts},
+            {"repair_successes", page.repair_successes},
+            {"errors", page.errors}};
+}
+
+ParsedPage parsed_page_from_json(const nlohmann::json& j) {
+    ParsedPage p;
+    if (!j.is_object()) return p;
+    if (j.contains("records") && j["records"].is_array()) p.records.assign(j["records"].begin(), j["records"].end());
+    p.validation_failures = j.value("validation_failures", 0);
+    p.repair_attempts = j.value("repair_attempts", 0);
+    p.repair_successes = j.value("repair_successes", 0);
+    p.errors = j.value("errors", std::vector<std::string>{});
+    return p;
+}
+
+void write_report(const std::string& out_dir, const RunReport& report) {
+    fs::create_directories(out_dir);
 
     std::ofstream f(out_dir + "/report.json");
-    if (f) f << j.dump(2);
+    if (f) f << report_to_json(report).dump(2);
 
     std::ofstream md(out_dir + "/report.md");
     if (md) {
         md << "# Run Report\n\n";
         md << "- Pages crawled: " << report.pages_crawled << "\n";
+        md << "- Listing pages reached through pagination: " << report.pagination_pages << "\n";
+        md << "- Links not fetched (predicted SKIP): " << report.links_predicted_skip << "\n";
+        md << "- Link graph: " << report.graph_urls << " URLs, " << report.graph_links << " links ("
+           << report.links_boosted << " queued URLs moved up by in-degree)\n";
+        size_t alias_count = 0;
+        for (const auto& [page, urls] : report.aliases) alias_count += urls.size();
+        md << "- Alias URLs collapsed (redirects, canonical links): " << alias_count << "\n";
+        md << "- Near-duplicate pages skipped: " << report.duplicates.size() << "\n";
         md << "- Pages kept: " << report.pages_kept << "\n";
+        md << "- Pages unchanged (results reused): " << report.pages_reused << "\n";
         md << "- Records emitted: " << report.records_emitted << "\n";
         md << "- Validation failures: " << report.validation_failures << "\n";
         md << "- Repair attempts: " << report.repair_attempts << "\n";
@@ -38,10 +135,38 @@ void write_report(const std::string& out_dir, const RunReport& report) {
         md << "- Tokens estimate: " << report.tokens_estimate << "\n";
         md << "- Crawl time (ms): " << report.crawl_ms.count() << "\n";
         md << "- LLM time (ms): " << report.llm_ms.count() << "\n";
+        if (!report.transfer_by_host.empty()) {
+            md << "\n## Transfer by host\n\n";
+            md << "| Host | Pages | Wire bytes | Decoded bytes |\n|------|-------|------------|---------------|\n";
+            for (const auto& [host, s] : report.transfer_by_host)
+                md << "| " << host << " | " << s.pages << " | " << s.wire_bytes << " | " << s.decoded_bytes << " |\n";
+        }
         if (!report.errors.empty()) {
             md << "\n## Errors\n\n";
             for (const auto& e : report.errors) md << "- " << e << "\n";
         }
+        if (!report.templates.empty()) {
+            // Busiest templates only; report.json has them all.
+            std::vector<std::pair<std::string, TemplateStats>> busiest(report.templates.begin(), report.templates.end());
+            std::stable_sort(busiest.begin(), busiest.end(),
+                             [](const auto& a, const auto& b) { return a.second.queued > b.second.queued; });
+            if (busiest.size() > 20) busiest.resize(20);
+            md << "\n## URL templates\n\n";
+            md << "| Template | Queued | Fetched | On topic | Skipped |\n|----------|--------|---------|----------|---------|\n";
+            for (const auto& [tpl, s] : busiest)
+                md << "| `" << tpl << "` | " << s.queued << " | " << s.fetched << " | " << s.on_topic << " | " << s.skipped << " |\n";
+        }
+        if (!report.aliases.empty()) {
+            md << "\n## URL aliases\n\n";
+            for (const auto& [page, urls] : report.aliases) {
+                md << "- " << page << "\n";
+                for (const auto& u : urls) md << "  - " << u << "\n";
+            }
+        }
+        if (!report.duplicates.empty()) {
+            md << "\n## Near-duplicate pages\n\n";
+            for (const auto& d : report.duplicates) md << "- " << d.url << " (same as " << d.duplicate_of << ")\n";
+        }
         if (!report.pages_visited.empty()) {
             md << "\n## Pages visited\n\n";
             for (const auto& p : report.pages_visited) md << "- " << p << "\n";
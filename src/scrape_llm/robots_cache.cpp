@@ -0,0 +1,83 @@
+#include "scrape_llm/robots_cache.hpp"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace scrapellm {
+
+namespace fs = std::filesystem;
+
+RobotsCache::RobotsCache(Options options)
+    : options_(std::move(options))
+{
+    if (options_.path.empty()) return;
+    std::ifstream f(options_.path);
+    if (!f) return;
+    try {
+        auto j = nlohmann::json::parse(f);
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            const auto& v = it.value();
+            entries_[it.key()] = make_entry(v.value("status", 0), v.value("body", ""),
+                                            v.value("fetched_at", static_cast<int64_t>(0)));
+        }
+    } catch (...) {
+        entries_.clear();  // corrupt file: robots.txt is refetched per origin
+    }
+}
+
+RobotsCache::EntryPtr RobotsCache::make_entry(int status, std::string body, int64_t fetched_at) {
+    auto rules = std::make_shared<docscraper::fetch::RobotsHandler>();
+    if (status == 200) rules->parse(body);
+    else if (status == 0 || status >= 500) rules->parse("User-agent: *\nDisallow: /\n");
+    if (status != 200) body.clear();
+    auto e = std::make_shared<Entry>();
+    e->status = status;
+    e->fetched_at = fetched_at;
+    e->body = std::move(body);
+    e->rules = std::move(rules);
+    return e;
+}
+
+bool RobotsCache::fresh(const Entry& e, int64_t now) const {
+    bool definitive = e.status >= 200 && e.status < 500;
+    return now - e.fetched_at < (definitive ? options_.ttl_s : options_.error_ttl_s);
+}
+
+RobotsCache::EntryPtr RobotsCache::get(const std::string& origin, int64_t now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(origin);
+    if (it == entries_.end() || !fresh(*it->second, now)) return nullptr;
+    return it->second;
+}
+
+RobotsCache::EntryPtr RobotsCache::put(const std::string& origin, int status, std::string body, int64_t now) {
+    EntryPtr e = make_entry(status, std::move(body), now);
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[origin] = e;
+    dirty_ = true;
+    return e;
+}
+
+bool RobotsCache::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dirty_ || options_.path.empty()) return true;
+    nlohmann::json j = nlohmann::json::object();
+    for (const auto& [origin, e] : entries_) {
+        j[origin] = {{"status", e->status}, {"fetched_at", e->fetched_at}, {"body", e->body}};
+    }
+    std::error_code ec;
+    fs::create_directories(fs::path(options_.path).parent_path(), ec);
+    std::string tmp = options_.path + ".tmp";
+    {
+        std::ofstream f(tmp);
+        if (!f) return false;
+        f << j.dump(2, ' ', false, nlohmann::json::error_handler_t::replace);  // bodies need not be UTF-8
+        if (!f) return false;
+    }
+    fs::rename(tmp, options_.path, ec);
+    if (ec) return false;
+    dirty_ = false;
+    return true;
+}
+
+} // namespace scrapellm
@@ -1,8 +1,9 @@
 #include "scrape_llm/ssrf_guard.hpp"
 #include "parse/normalizer.hpp"
 #include <algorithm>
+#include <arpa/inet.h>
 #include <cctype>
-#include <sstream>
+#include <cstring>
 
 namespace scrapellm {
 
@@ -20,22 +21,51 @@ bool is_http_or_https(const std::string& url) {
     return scheme == "http" || scheme == "https";
 }
 
-// Check if host is localhost or private IP range.
+static bool is_private_v4(const unsigned char* a) {
+    if (a[0] == 0 || a[0] == 10 || a[0] == 127) return true;           // this network, 10/8, loopback
+    if (a[0] == 100 && (a[1] & 0xC0) == 64) return true;                // 100.64/10 carrier-grade NAT
+    if (a[0] == 169 && a[1] == 254) return true;                        // link-local (cloud metadata)
+    if (a[0] == 172 && (a[1] & 0xF0) == 16) return true;                // 172.16/12
+    if (a[0] == 192 && a[1] == 168) return true;                        // 192.168/16
+    if (a[0] == 192 && a[1] == 0 && a[2] == 0) return true;             // 192.0.0/24 protocol assignments
+    if (a[0] == 198 && (a[1] & 0xFE) == 18) return true;                // 198.18/15 benchmarking
+    return a[0] >= 224;                                                 // multicast, reserved, broadcast
+}
+
+bool is_private_address(const std::string& ip) {
+    std::string h = ip;
+    if (h.size() > 2 && h.front() == '[' && h.back() == ']') h = h.substr(1, h.size() - 2);
+
+    unsigned char v4[4];
+    if (inet_pton(AF_INET, h.c_str(), v4) == 1) return is_private_v4(v4);
+
+    unsigned char v6[16];
+    if (inet_pton(AF_INET6, h.c_str(), v6) != 1) return false;
+    static const unsigned char zero[16] = {};
+    if (std::memcmp(v6, zero, 15) == 0 && (v6[15] == 0 || v6[15] == 1)) return true;  // :: and ::1
+    // IPv4-mapped (::ffff:a.b.c.d), IPv4-compatible (::a.b.c.d) and NAT64 (64:ff9b::a.b.c.d)
+    // carry an IPv4 address in the low 32 bits that the connection effectively reaches.
+    static const unsigned char mapped[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    static const unsigned char nat64[12] = {0, 0x64, 0xff, 0x9b, 0, 0, 0, 0, 0, 0, 0, 0};
+    if (std::memcmp(v6, mapped, 12) == 0 || std::memcmp(v6, zero, 12) == 0 || std::memcmp(v6, nat64, 12) == 0)
+        return is_private_v4(v6 + 12);
+    if ((v6[0] & 0xFE) == 0xFC) return true;                            // fc00::/7 unique local
+    if (v6[0] == 0xFE && (v6[1] & 0xC0) == 0x80) return true;           // fe80::/10 link-local
+    if (v6[0] == 0xFE && (v6[1] & 0xC0) == 0xC0) return true;           // fec0::/10 site-local (deprecated)
+    return v6[0] == 0xFF;                                               // multicast
+}
+
+std::string first_private_address(const std::vector<std::string>& addresses) {
+    for (const auto& a : addresses)
+        if (is_private_address(a)) return a;
+    return "";
+}
+
+// Literal check only: localhost names and IP literals. Names are checked after resolution.
 static bool is_private_host(const std::string& host) {
     std::string h = to_lower(host);
-    if (h == "localhost" || h == "127.0.0.1" || h == "::1" || h == "[::1]") return true;
-    if (h.find("127.") == 0) return true;  // 127.0.0.0/8
-
-    // IPv4 private: 10.x, 172.16-31.x, 192.168.x
-    std::istringstream iss(h);
-    int a = 0, b = 0, c = 0, d = 0;
-    char dot;
-    if (iss >> a >> dot >> b >> dot >> c >> dot >> d) {
-        if (a == 10) return true;
-        if (a == 172 && b >= 16 && b <= 31) return true;
-        if (a == 192 && b == 168) return true;
-    }
-    return false;
+    if (h == "localhost" || (h.size() > 10 && h.compare(h.size() - 10, 10, ".localhost") == 0)) return true;
+    return is_private_address(h);
 }
 
 bool url_allowed_ssrf(const std::string& url, bool allow_private_network) {
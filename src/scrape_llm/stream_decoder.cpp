@@ -0,0 +1,144 @@
+#include "scrape_llm/stream_decoder.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <cctype>
+#ifdef SCRAPE_LLM_HAVE_BROTLI
+#include <brotli/decode.h>
+#endif
+
+namespace scrapellm {
+
+namespace {
+
+constexpr size_t kOutChunk = 16 * 1024;
+
+std::string normalize_coding(const std::string& value) {
+    std::string s;
+    for (char c : value) {
+        if (!std::isspace(static_cast<unsigned char>(c))) s += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    if (s == "x-gzip") return "gzip";
+    return s;
+}
+
+// gzip and zlib-wrapped deflate via inflate's header autodetection. Some servers send raw
+// deflate for "deflate"; if the first bytes are not a zlib header, retry as raw.
+class ZlibDecoder : public StreamDecoder {
+public:
+    explicit ZlibDecoder(bool deflate) : deflate_(deflate) { init(15 + 32); }
+    ~ZlibDecoder() override { inflateEnd(&zs_); }
+
+    bool write(const char* data, size_t len, const Sink& sink) override {
+        if (!ok_) return false;
+        if (finished_) return true;  // trailing garbage after the stream end is ignored
+        if (deflate_ && !produced_any_) probe_.append(data, len);
+        zs_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        zs_.avail_in = static_cast<uInt>(len);
+        char out[kOutChunk];
+        while (zs_.avail_in > 0) {
+            zs_.next_out = reinterpret_cast<Bytef*>(out);
+            zs_.avail_out = sizeof(out);
+            int rc = inflate(&zs_, Z_NO_FLUSH);
+            if (rc == Z_DATA_ERROR && deflate_ && !produced_any_) {
+                // Not a zlib header: replay everything received so far as raw deflate.
+                inflateEnd(&zs_);
+                init(-15);
+                deflate_ = false;
+                std::string replay = std::move(probe_);
+                return write(replay.data(), replay.size(), sink);
+            }
+            if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) {
+                ok_ = false;
+                return false;
+            }
+            size_t have = sizeof(out) - zs_.avail_out;
+            if (have > 0) {
+                produced_any_ = true;
+                probe_.clear();
+                if (!sink(out, have)) return false;
+            }
+            if (rc == Z_STREAM_END) {
+                finished_ = true;
+                break;
+            }
+            if (rc == Z_BUF_ERROR) break;
+        }
+        return true;
+    }
+
+    bool finished() const override { return finished_; }
+
+private:
+    z_stream zs_{};
+    bool deflate_ = false;
+    bool ok_ = false;
+    bool produced_any_ = false;
+    bool finished_ = false;
+    std::string probe_;  // "deflate" input held until the zlib header is known to be valid
+
+    void init(int window_bits) {
+        zs_ = z_stream{};
+        ok_ = inflateInit2(&zs_, window_bits) == Z_OK;
+    }
+};
+
+#ifdef SCRAPE_LLM_HAVE_BROTLI
+class BrotliDecoder : public StreamDecoder {
+public:
+    BrotliDecoder() : state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)) {}
+    ~BrotliDecoder() override { BrotliDecoderDestroyInstance(state_); }
+
+    bool write(const char* data, size_t len, const Sink& sink) override {
+        if (!state_) return false;
+        const uint8_t* next_in = reinterpret_cast<const uint8_t*>(data);
+        size_t avail_in = len;
+        uint8_t out[kOutChunk];
+        for (;;) {
+            uint8_t* next_out = out;
+            size_t avail_out = sizeof(out);
+            auto rc = BrotliDecoderDecompressStream(state_, &avail_in, &next_in, &avail_out, &next_out, nullptr);
+            size_t have = sizeof(out) - avail_out;
+            if (have > 0 && !sink(reinterpret_cast<const char*>(out), have)) return false;
+            if (rc == BROTLI_DECODER_RESULT_ERROR) return false;
+            if (rc == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) continue;
+            return true;  // NEEDS_MORE_INPUT or SUCCESS
+        }
+    }
+
+    bool finished() const override { return state_ && BrotliDecoderIsFinished(state_); }
+
+private:
+    BrotliDecoderState* state_;
+};
+#endif
+
+} // namespace
+
+std::unique_ptr<StreamDecoder> StreamDecoder::create(const std::string& content_encoding) {
+    std::string coding = normalize_coding(content_encoding);
+    if (coding == "gzip") return std::make_unique<ZlibDecoder>(false);
+    if (coding == "deflate") return std::make_unique<ZlibDecoder>(true);
+#ifdef SCRAPE_LLM_HAVE_BROTLI
+    if (coding == "br") return std::make_unique<BrotliDecoder>();
+#endif
+    return nullptr;
+}
+
+bool StreamDecoder::supports_encoding(const std::string& content_encoding) {
+    std::string coding = normalize_coding(content_encoding);
+    if (coding.empty() || coding == "identity" || coding == "gzip" || coding == "deflate") return true;
+#ifdef SCRAPE_LLM_HAVE_BROTLI
+    if (coding == "br") return true;
+#endif
+    return false;
+}
+
+const char* StreamDecoder::accept_encoding() {
+#ifdef SCRAPE_LLM_HAVE_BROTLI
+    return "br, gzip, deflate";
+#else
+    return "gzip, deflate";
+#endif
+}
+
+} // namespace scrapellm
@@ -0,0 +1,108 @@
+#include "scrape_llm/url_template.hpp"
+#include "parse/normalizer.hpp"
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace scrapellm {
+
+namespace {
+
+constexpr size_t kLongSegment = 40;
+
+bool all_digits(const std::string& s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+bool all_hex(const std::string& s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isxdigit(c); });
+}
+
+bool all_alnum(const std::string& s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isalnum(c); });
+}
+
+bool is_uuid(const std::string& s) {
+    if (s.size() != 36) return false;
+    for (size_t i = 0; i < s.size(); ++i) {
+        bool dash = i == 8 || i == 13 || i == 18 || i == 23;
+        if (dash ? s[i] != '-' : !std::isxdigit(static_cast<unsigned char>(s[i]))) return false;
+    }
+    return true;
+}
+
+std::string mask_segment(const std::string& segment) {
+    std::string base = segment;
+    std::string ext;
+    size_t dot = segment.rfind('.');
+    if (dot != std::string::npos && dot > 0 && segment.size() - dot - 1 <= 5 &&
+        all_alnum(segment.substr(dot + 1))) {
+        base = segment.substr(0, dot);
+        ext = segment.substr(dot);
+    }
+
+    bool has_digit = std::any_of(base.begin(), base.end(), [](unsigned char c) { return std::isdigit(c); });
+    bool has_alpha = std::any_of(base.begin(), base.end(), [](unsigned char c) { return std::isalpha(c); });
+    size_t separators = static_cast<size_t>(std::count_if(base.begin(), base.end(), [](char c) { return c == '-' || c == '_'; }));
+
+    std::string masked;
+    if (all_digits(base)) masked = "{num}";
+    else if (is_uuid(base) || (base.size() >= 16 && all_hex(base))) masked = "{hash}";
+    else if (base.size() > kLongSegment || base.find('%') != std::string::npos || separators >= 2) masked = "{slug}";
+    else if (has_digit && has_alpha && base.size() >= 4) masked = separators ? "{slug}" : "{id}";
+    else masked = base;
+    for (auto& c : masked) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return masked + ext;
+}
+
+} // namespace
+
+std::string url_template(const std::string& url) {
+    auto parsed = docscraper::parse::URLNormalizer::parse(url);
+    if (!parsed) return url;
+
+    std::string out;
+    const std::string& path = parsed->path;
+    size_t start = 0;
+    while (start < path.size()) {
+        size_t slash = path.find('/', start);
+        if (slash == std::string::npos) slash = path.size();
+        if (slash > start) out += "/" + mask_segment(path.substr(start, slash - start));
+        start = slash + 1;
+    }
+    if (out.empty() || (!path.empty() && path.back() == '/')) out += "/";
+
+    if (!parsed->query.empty()) {
+        std::vector<std::string> params;
+        size_t pos = 0;
+        while (pos <= parsed->query.size()) {
+            size_t amp = parsed->query.find('&', pos);
+            if (amp == std::string::npos) amp = parsed->query.size();
+            std::string param = parsed->query.substr(pos, amp - pos);
+            if (!param.empty()) {
+                size_t eq = param.find('=');
+                std::string key = param.substr(0, eq);
+                std::string value = eq == std::string::npos ? "" : param.substr(eq + 1);
+                params.push_back(key + "=" + (all_digits(value) ? "{num}" : "{val}"));
+            }
+            pos = amp + 1;
+        }
+        std::sort(params.begin(), params.end());
+        params.erase(std::unique(params.begin(), params.end()), params.end());
+        out += "?";
+        for (size_t i = 0; i < params.size(); ++i) out += (i ? "&" : "") + params[i];
+    }
+    return out;
+}
+
+bool TemplatePolicy::admit(const TemplateStats& stats) const {
+    if (options_.max_fetches > 0 && stats.fetched >= options_.max_fetches) return false;
+    if (options_.probe_fetches > 0 && stats.fetched >= options_.probe_fetches && stats.on_topic == 0) {
+        // Off-topic so far: keep sampling in case a later page proves otherwise.
+        int every = std::max(1, options_.sample_every);
+        return (stats.fetched + stats.skipped) % every == 0;
+    }
+    return true;
+}
+
+} // namespace scrapellm
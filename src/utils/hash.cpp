@@ -5,6 +5,7 @@
 #include <openssl/md5.h>
 #include <openssl/sha.h>
 #include <openssl/evp.h>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
@@ -104,4 +105,43 @@ std::string url_hash(const std::string& normalized_url) {
     return md5_hash(normalized_url);
 }
 
+uint64_t fingerprint64(const void* data, size_t length, uint64_t seed) {
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ^ (length * m);
+
+    size_t blocks = length / 8;
+    for (size_t i = 0; i < blocks; ++i) {
+        uint64_t k;
+        std::memcpy(&k, bytes + i * 8, sizeof(k));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    const unsigned char* tail = bytes + blocks * 8;
+    switch (length & 7) {
+        case 7: h ^= uint64_t(tail[6]) << 48; [[fallthrough]];
+        case 6: h ^= uint64_t(tail[5]) << 40; [[fallthrough]];
+        case 5: h ^= uint64_t(tail[4]) << 32; [[fallthrough]];
+        case 4: h ^= uint64_t(tail[3]) << 24; [[fallthrough]];
+        case 3: h ^= uint64_t(tail[2]) << 16; [[fallthrough]];
+        case 2: h ^= uint64_t(tail[1]) << 8; [[fallthrough]];
+        case 1: h ^= uint64_t(tail[0]);
+                h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+uint64_t fingerprint64(const std::string& data, uint64_t seed) {
+    return fingerprint64(data.data(), data.size(), seed);
+}
+
 } // namespace docscraper::utils
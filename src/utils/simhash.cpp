@@ -0,0 +1,108 @@
+// simhash.cpp - Near-Duplicate Text Fingerprints Implementation
+// LLM Documentation Scraper - C++ Implementation
+
+#include "utils/simhash.hpp"
+#include "utils/hash.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+
+namespace docscraper::utils {
+
+namespace {
+
+constexpr size_t kShingleWords = 3;
+
+// Lowercased runs of ASCII letters and digits; other bytes of UTF-8 sequences count as letters,
+// so non-Latin text still splits on spaces and punctuation.
+std::vector<uint64_t> word_hashes(const std::string& text) {
+    std::vector<uint64_t> words;
+    std::string word;
+    auto flush = [&] {
+        if (!word.empty()) words.push_back(fingerprint64(word));
+        word.clear();
+    };
+    for (unsigned char c : text) {
+        if (std::isalnum(c) || c >= 0x80) word += static_cast<char>(std::tolower(c));
+        else flush();
+    }
+    flush();
+    return words;
+}
+
+// Mix a shingle's word hashes order-sensitively (splitmix64 finalizer on a rotate-xor chain).
+uint64_t shingle_hash(const uint64_t* words) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < kShingleWords; ++i) {
+        h = std::rotl(h, 23) ^ words[i];
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+} // namespace
+
+uint64_t simhash64(const std::string& text) {
+    std::vector<uint64_t> words = word_hashes(text);
+    if (words.size() < std::max(kSimHashMinWords, kShingleWords)) return 0;
+
+    std::array<int64_t, 64> weights{};
+    for (size_t i = 0; i + kShingleWords <= words.size(); ++i) {
+        uint64_t h = shingle_hash(&words[i]);
+        for (int bit = 0; bit < 64; ++bit) weights[bit] += (h >> bit) & 1 ? 1 : -1;
+    }
+    uint64_t fp = 0;
+    for (int bit = 0; bit < 64; ++bit)
+        if (weights[bit] > 0) fp |= 1ULL << bit;
+    return fp ? fp : 1;  // 0 means "no fingerprint"
+}
+
+int hamming_distance(uint64_t a, uint64_t b) {
+    return std::popcount(a ^ b);
+}
+
+SimHashIndex::SimHashIndex(int max_distance)
+    : max_distance_(std::clamp(max_distance, 0, 63))
+{
+    int n = max_distance_ + 1;
+    int shift = 0;
+    for (int i = 0; i < n; ++i) {
+        int width = 64 / n + (i < 64 % n ? 1 : 0);
+        Block b;
+        b.shift = shift;
+        b.mask = width >= 64 ? ~0ULL : (1ULL << width) - 1;
+        blocks_.push_back(std::move(b));
+        shift += width;
+    }
+}
+
+std::optional<size_t> SimHashIndex::find(uint64_t fp) const {
+    std::optional<uint32_t> best;
+    for (const auto& b : blocks_) {
+        auto it = b.table.find((fp >> b.shift) & b.mask);
+        if (it == b.table.end()) continue;
+        for (uint32_t entry : it->second) {
+            if (best && entry >= *best) break;  // entries are in insertion order
+            if (hamming_distance(fp, fingerprints_[entry]) <= max_distance_) {
+                best = entry;
+                break;
+            }
+        }
+    }
+    if (!best) return std::nullopt;
+    return ids_[*best];
+}
+
+void SimHashIndex::insert(uint64_t fp, size_t id) {
+    auto entry = static_cast<uint32_t>(fingerprints_.size());
+    fingerprints_.push_back(fp);
+    ids_.push_back(id);
+    for (auto& b : blocks_) b.table[(fp >> b.shift) & b.mask].push_back(entry);
+}
+
+} // namespace docscraper::utils
@@ -0,0 +1,132 @@
+// url_seen_set.cpp - Compact URL Dedup Set Implementation
+// LLM Documentation Scraper - C++ Implementation
+
+#include "utils/url_seen_set.hpp"
+#include "utils/hash.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace docscraper::utils {
+
+namespace {
+
+// Rehash once the table is 3/4 full; linear probing degrades quickly beyond that.
+constexpr size_t kMaxLoadNum = 3;
+constexpr size_t kMaxLoadDen = 4;
+
+size_t round_up_pow2(size_t n) {
+    size_t p = 16;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+UrlSeenSet::UrlSeenSet() : UrlSeenSet(Options{}) {}
+
+UrlSeenSet::UrlSeenSet(Options options)
+    : options_(options)
+{
+    rehash(round_up_pow2(options_.expected_urls * kMaxLoadDen / kMaxLoadNum + 1));
+    if (options_.bloom_fp_rate > 0.0 && options_.bloom_fp_rate < 1.0) {
+        // Standard sizing: m = -n ln p / (ln 2)^2 bits, k = m/n ln 2 hash functions.
+        double n = static_cast<double>(std::max<size_t>(options_.expected_urls, 1));
+        double ln2 = std::log(2.0);
+        double m = std::ceil(-n * std::log(options_.bloom_fp_rate) / (ln2 * ln2));
+        bloom_bits_ = std::max<uint64_t>(64, static_cast<uint64_t>(m));
+        bloom_hashes_ = std::clamp(static_cast<int>(std::lround(m / n * ln2)), 1, 16);
+        bloom_.assign((bloom_bits_ + 63) / 64, 0);
+    }
+}
+
+uint64_t UrlSeenSet::fingerprint(const std::string& url) {
+    uint64_t fp = fingerprint64(url);
+    return fp ? fp : 1;  // 0 marks an empty slot
+}
+
+bool UrlSeenSet::insert(const std::string& url) {
+    return insert_fingerprint(fingerprint(url));
+}
+
+bool UrlSeenSet::contains(const std::string& url) const {
+    return contains_fingerprint(fingerprint(url));
+}
+
+// Bloom probes use double hashing (Kirsch-Mitzenmacher) on the two halves of the fingerprint,
+// which is already well mixed, so no extra hashing is needed.
+bool UrlSeenSet::bloom_maybe(uint64_t fp) const {
+    uint64_t h1 = fp;
+    uint64_t h2 = (fp >> 32) | (fp << 32) | 1;
+    for (int i = 0; i < bloom_hashes_; ++i) {
+        uint64_t bit = (h1 + static_cast<uint64_t>(i) * h2) % bloom_bits_;
+        if (!(bloom_[bit >> 6] & (1ULL << (bit & 63)))) return false;
+    }
+    return true;
+}
+
+void UrlSeenSet::bloom_add(uint64_t fp) {
+    uint64_t h1 = fp;
+    uint64_t h2 = (fp >> 32) | (fp << 32) | 1;
+    for (int i = 0; i < bloom_hashes_; ++i) {
+        uint64_t bit = (h1 + static_cast<uint64_t>(i) * h2) % bloom_bits_;
+        bloom_[bit >> 6] |= 1ULL << (bit & 63);
+    }
+}
+
+bool UrlSeenSet::contains_fingerprint(uint64_t fp) const {
+    if (fp == 0) fp = 1;
+    if (bloom_hashes_ && !bloom_maybe(fp)) return false;
+    for (size_t i = fp & mask_;; i = (i + 1) & mask_) {
+        if (slots_[i] == fp) return true;
+        if (slots_[i] == 0) return false;
+    }
+}
+
+bool UrlSeenSet::insert_fingerprint(uint64_t fp) {
+    if (fp == 0) fp = 1;
+    bool maybe = !bloom_hashes_ || bloom_maybe(fp);
+    size_t i = fp & mask_;
+    if (maybe) {
+        for (; slots_[i] != 0; i = (i + 1) & mask_)
+            if (slots_[i] == fp) return false;
+    } else {
+        while (slots_[i] != 0) i = (i + 1) & mask_;
+    }
+    slots_[i] = fp;
+    ++size_;
+    if (bloom_hashes_) bloom_add(fp);
+    if (size_ * kMaxLoadDen > slots_.size() * kMaxLoadNum) rehash(slots_.size() * 2);
+    return true;
+}
+
+void UrlSeenSet::rehash(size_t capacity) {
+    std::vector<uint64_t> old = std::move(slots_);
+    slots_.assign(capacity, 0);
+    mask_ = capacity - 1;
+    for (uint64_t fp : old) {
+        if (fp == 0) continue;
+        size_t i = fp & mask_;
+        while (slots_[i] != 0) i = (i + 1) & mask_;
+        slots_[i] = fp;
+    }
+}
+
+size_t UrlSeenSet::memory_bytes() const {
+    return slots_.capacity() * sizeof(uint64_t) + bloom_.capacity() * sizeof(uint64_t);
+}
+
+void UrlSeenSet::clear() {
+    std::fill(slots_.begin(), slots_.end(), 0);
+    std::fill(bloom_.begin(), bloom_.end(), 0);
+    size_ = 0;
+}
+
+std::vector<uint64_t> UrlSeenSet::fingerprints() const {
+    std::vector<uint64_t> out;
+    out.reserve(size_);
+    for (uint64_t fp : slots_)
+        if (fp != 0) out.push_back(fp);
+    return out;
+}
+
+} // namespace docscraper::utils
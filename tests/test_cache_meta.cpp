@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/cache_meta.hpp"
+#include "test_helpers.hpp"
+#include <fstream>
+#include <string>
+
+using scrapellm::CacheEntryMeta;
+using scrapellm::CacheMetaStore;
+using scrapellm::cache_control_no_store;
+using scrapellm::cache_entry_fresh;
+using scrapellm::testutil::fresh_temp_dir;
+
+namespace {
+
+CacheEntryMeta fetched(int64_t at, const std::string& cache_control) {
+    CacheEntryMeta m;
+    m.cache_control = cache_control;
+    m.fetched_at = at;
+    return m;
+}
+
+} // namespace
+
+TEST(CacheMeta, MaxAgeBoundsFreshness) {
+    auto m = fetched(1000, "public, max-age=60");
+    EXPECT_TRUE(cache_entry_fresh(m, 1059, 3600));
+    EXPECT_FALSE(cache_entry_fresh(m, 1060, 3600));
+    EXPECT_TRUE(cache_entry_fresh(fetched(1000, "Max-Age=60"), 1030, 0));
+}
+
+TEST(CacheMeta, SharedMaxAgeWinsOverMaxAge) {
+    auto m = fetched(1000, "max-age=10, s-maxage=100");
+    EXPECT_TRUE(cache_entry_fresh(m, 1050, 0));
+    EXPECT_FALSE(cache_entry_fresh(m, 1100, 0));
+}
+
+TEST(CacheMeta, NoCacheIsNeverFresh) {
+    EXPECT_FALSE(cache_entry_fresh(fetched(1000, "no-cache, max-age=600"), 1001, 3600));
+    // A directive that merely contains the name does not count.
+    EXPECT_TRUE(cache_entry_fresh(fetched(1000, "x-no-cache-hint, max-age=600"), 1001, 3600));
+}
+
+TEST(CacheMeta, DefaultAgeAppliesWithoutMaxAge) {
+    auto m = fetched(1000, "");
+    EXPECT_TRUE(cache_entry_fresh(m, 1299, 300));
+    EXPECT_FALSE(cache_entry_fresh(m, 1300, 300));
+    EXPECT_FALSE(cache_entry_fresh(fetched(1000, "max-age=oops"), 1001, 0));
+}
+
+TEST(CacheMeta, NoStoreDirective) {
+    EXPECT_TRUE(cache_control_no_store("no-store"));
+    EXPECT_TRUE(cache_control_no_store("private, No-Store, max-age=0"));
+    EXPECT_FALSE(cache_control_no_store("no-cache, max-age=0"));
+    EXPECT_FALSE(cache_control_no_store("no-stored"));
+    EXPECT_FALSE(cache_control_no_store(""));
+}
+
+TEST(CacheMeta, StoreRoundTripsAndRetains) {
+    std::string dir = fresh_temp_dir("cache_meta");
+    std::string path = dir + "/meta.json";
+    {
+        CacheMetaStore store(path);
+        store.put("https://example.com/a", CacheEntryMeta{"\"v1\"", "Tue, 01 Sep 2026 10:00:00 GMT", "max-age=60", 1000});
+        store.put("https://example.com/b", CacheEntryMeta{"\"v2\"", "", "", 2000});
+        store.put("https://example.com/c", CacheEntryMeta{"", "", "", 3000});
+        store.erase("https://example.com/c");
+        ASSERT_TRUE(store.save());
+    }
+    {
+        CacheMetaStore store(path);
+        auto a = store.get("https://example.com/a");
+        ASSERT_TRUE(a.has_value());
+        EXPECT_EQ(a->etag, "\"v1\"");
+        EXPECT_EQ(a->last_modified, "Tue, 01 Sep 2026 10:00:00 GMT");
+        EXPECT_EQ(a->cache_control, "max-age=60");
+        EXPECT_EQ(a->fetched_at, 1000);
+        EXPECT_TRUE(store.get("https://example.com/b").has_value());
+        EXPECT_FALSE(store.get("https://example.com/c").has_value());
+
+        // Entries of pages that left the page cache are dropped and stay dropped.
+        store.retain([](const std::string& url) { return url == "https://example.com/a"; });
+        ASSERT_TRUE(store.save());
+    }
+    CacheMetaStore store(path);
+    EXPECT_TRUE(store.get("https://example.com/a").has_value());
+    EXPECT_FALSE(store.get("https://example.com/b").has_value());
+}
+
+TEST(CacheMeta, CorruptFileStartsEmpty) {
+    std::string dir = fresh_temp_dir("cache_meta_corrupt");
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir + "/meta.json") << "{\"https://example.com/a\": {\"etag\": ";
+    CacheMetaStore store(dir + "/meta.json");
+    EXPECT_FALSE(store.get("https://example.com/a").has_value());
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/checkpoint.hpp"
+#include "test_helpers.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace scrapellm;
+using docscraper::utils::UrlSeenSet;
+using scrapellm::testutil::fresh_temp_dir;
+
+namespace {
+
+RunConfig make_config(const std::string& dir) {
+    RunConfig c;
+    c.url = "https://example.com/";
+    c.schema = "product names and prices";
+    c.out_dir = dir;
+    return c;
+}
+
+} // namespace
+
+TEST(Checkpoint, CrawlStateRoundTrips) {
+    RunConfig config = make_config(fresh_temp_dir("checkpoint_roundtrip"));
+    Checkpoint saver(config);
+    saver.reset();
+
+    CrawlFrontier frontier(CrawlFrontier::Options{true, 0, ""});
+    frontier.push({"https://example.com/b", 1, 0, 2.0});
+    frontier.push({"https://example.com/c", 2, 1700000000, 5.0});
+    UrlSeenSet seen;
+    for (const char* u : {"https://example.com/", "https://example.com/a", "https://example.com/b", "https://example.com/c"})
+        seen.insert(u);
+    Checkpoint::CrawlState state;
+    state.crawled.push_back({"https://example.com/", "https://example.com/", "https://example.com/", 0});
+    state.report.pages_crawled = 1;
+    state.report.errors.push_back("https://example.com/x: HTTP 404");
+    std::vector<CrawlFrontier::Entry> in_flight{{"https://example.com/a", 1, 0, 1.0}};
+    ASSERT_TRUE(saver.save_crawl(state, frontier, in_flight, seen));
+    // A second save supersedes the first.
+    state.report.pages_crawled = 2;
+    ASSERT_TRUE(saver.save_crawl(state, frontier, in_flight, seen));
+
+    Checkpoint loader(config);
+    Checkpoint::CrawlState loaded;
+    CrawlFrontier restored(CrawlFrontier::Options{true, 0, ""});
+    UrlSeenSet restored_seen;
+    ASSERT_TRUE(loader.load(loaded, restored, restored_seen));
+    EXPECT_FALSE(loaded.done);
+    EXPECT_EQ(loaded.report.pages_crawled, 2);
+    EXPECT_EQ(loaded.report.errors, state.report.errors);
+    ASSERT_EQ(loaded.crawled.size(), 1u);
+    EXPECT_EQ(loaded.crawled[0].normalized_url, "https://example.com/");
+    EXPECT_EQ(restored_seen.size(), 4u);
+    EXPECT_TRUE(restored_seen.contains("https://example.com/a"));
+
+    // The in-flight URL is queued again, in score order with the rest.
+    ASSERT_EQ(restored.size(), 3u);
+    auto first = restored.pop();
+    EXPECT_EQ(first.url, "https://example.com/c");
+    EXPECT_EQ(first.lastmod, 1700000000);
+    EXPECT_EQ(restored.pop().url, "https://example.com/b");
+    EXPECT_EQ(restored.pop().url, "https://example.com/a");
+}
+
+TEST(Checkpoint, LinksSpilledFrontierSegments) {
+    std::string dir = fresh_temp_dir("checkpoint_spill");
+    RunConfig config = make_config(dir);
+    Checkpoint saver(config);
+    CrawlFrontier frontier(CrawlFrontier::Options{true, 16, dir + "/frontier"});
+    for (int i = 0; i < 200; ++i) frontier.push({"https://example.com/" + std::to_string(i), 1, 0, 1.0 + i % 2});
+    ASSERT_LT(frontier.in_memory(), frontier.size());
+    ASSERT_TRUE(saver.save_crawl(Checkpoint::CrawlState{}, frontier, {}, UrlSeenSet()));
+
+    // Draining the live frontier deletes its segments; the checkpoint keeps its own links.
+    std::vector<std::string> expected;
+    while (!frontier.empty()) expected.push_back(frontier.pop().url);
+
+    // Loading spills into the restored frontier rather than holding the saved one in memory.
+    Checkpoint loader(config);
+    Checkpoint::CrawlState state;
+    CrawlFrontier restored(CrawlFrontier::Options{true, 16, dir + "/restored"});
+    UrlSeenSet seen;
+    ASSERT_TRUE(loader.load(state, restored, seen));
+    EXPECT_EQ(restored.size(), 200u);
+    EXPECT_LE(restored.in_memory(), 16u + 2u);
+    std::vector<std::string> order;
+    while (!restored.empty()) order.push_back(restored.pop().url);
+    EXPECT_EQ(order, expected);
+
+    // A missing segment makes the generation unusable rather than silently short.
+    for (const auto& e : std::filesystem::directory_iterator(dir + "/checkpoint"))
+        if (e.path().extension() == ".seg") std::filesystem::remove(e.path());
+    CrawlFrontier partial(CrawlFrontier::Options{true, 0, ""});
+    EXPECT_FALSE(Checkpoint(config).load(state, partial, seen));
+    EXPECT_TRUE(partial.empty());
+}
+
+TEST(Checkpoint, RejectsDifferentRun) {
+    RunConfig config = make_config(fresh_temp_dir("checkpoint_other_run"));
+    Checkpoint saver(config);
+    CrawlFrontier frontier(CrawlFrontier::Options{});
+    ASSERT_TRUE(saver.save_crawl(Checkpoint::CrawlState{}, frontier, {}, UrlSeenSet()));
+
+    RunConfig other = config;
+    other.schema = "something else";
+    Checkpoint loader(other);
+    Checkpoint::CrawlState state;
+    CrawlFrontier restored(CrawlFrontier::Options{});
+    UrlSeenSet seen;
+    EXPECT_FALSE(loader.load(state, restored, seen));
+}
+
+TEST(Checkpoint, MemosSurviveATornLine) {
+    RunConfig config = make_config(fresh_temp_dir("checkpoint_memos"));
+    {
+        Checkpoint cp(config);
+        CrawlFrontier frontier(CrawlFrontier::Options{});
+        ASSERT_TRUE(cp.save_crawl(Checkpoint::CrawlState{}, frontier, {}, UrlSeenSet()));
+        cp.record_relevance("https://example.com/a", RelevanceDecision{true, "product list"});
+        ParsedPage page;
+        page.records.push_back({{"name", "Widget"}, {"price", 9.5}});
+        page.repair_attempts = 1;
+        cp.record_parsed("https://example.com/a", page);
+    }
+    // A kill mid-write leaves half a line behind.
+    std::ofstream(config.out_dir + "/checkpoint/relevance.jsonl", std::ios::app) << "{\"url\": \"https://exa";
+
+    Checkpoint cp(config);
+    Checkpoint::CrawlState state;
+    CrawlFrontier frontier(CrawlFrontier::Options{});
+    UrlSeenSet seen;
+    ASSERT_TRUE(cp.load(state, frontier, seen));
+    const RelevanceDecision* d = cp.relevance("https://example.com/a");
+    ASSERT_NE(d, nullptr);
+    EXPECT_TRUE(d->keep);
+    EXPECT_EQ(cp.relevance("https://example.com/b"), nullptr);
+    const ParsedPage* p = cp.parsed("https://example.com/a");
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(p->records.size(), 1u);
+    EXPECT_EQ(p->records[0]["name"], "Widget");
+    EXPECT_EQ(p->repair_attempts, 1);
+}
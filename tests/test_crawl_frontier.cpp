@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/crawl_frontier.hpp"
+#include "test_helpers.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using scrapellm::CrawlFrontier;
+using scrapellm::testutil::fresh_temp_dir;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Budget plus one reloaded segment (max_in_memory / 8).
+constexpr size_t kBudget = 64;
+constexpr size_t kMemoryBound = kBudget + kBudget / 8;
+
+// Three priorities and two depths, so entries spread over six buckets.
+CrawlFrontier::Entry numbered(int i) {
+    return {"u" + std::to_string(i), 1 + i % 2, 0, static_cast<double>(i % 3)};
+}
+
+// Pops everything, checking score, depth and FIFO order for the numbered() entries.
+std::vector<int> drain_in_order(CrawlFrontier& f) {
+    std::vector<int> indices;
+    double last_score = 1e9;
+    int last_depth = -1;
+    int last_index = -1;
+    while (!f.empty()) {
+        auto e = f.pop();
+        int index = std::stoi(e.url.substr(1));
+        EXPECT_LE(e.score, last_score);
+        if (e.score == last_score) {
+            EXPECT_GE(e.depth, last_depth);
+            if (e.depth == last_depth) {
+                EXPECT_GT(index, last_index);  // FIFO within a bucket
+            }
+        }
+        last_score = e.score;
+        last_depth = e.depth;
+        last_index = index;
+        indices.push_back(index);
+    }
+    return indices;
+}
+
+} // namespace
+
+TEST(CrawlFrontier, BfsByDepthThenInsertionIgnoringScore) {
+    CrawlFrontier f(CrawlFrontier::Options{false, 0, ""});
+    f.push({"a", 2, 0, 1.0});
+    f.push({"b", 1, 0, 5.0});
+    f.push({"c", 1, 0, 9.0});
+    EXPECT_EQ(f.pop().url, "b");
+    EXPECT_EQ(f.pop().url, "c");
+    EXPECT_EQ(f.pop().url, "a");
+    EXPECT_TRUE(f.empty());
+}
+
+TEST(CrawlFrontier, BestFirstByScoreThenDepthThenAge) {
+    CrawlFrontier f(CrawlFrontier::Options{true, 0, ""});
+    f.push({"low", 1, 0, 1.0});
+    f.push({"deep", 3, 0, 5.0});
+    f.push({"high", 2, 0, 5.0});
+    f.push({"high2", 2, 0, 5.0});
+    f.push({"top", 4, 0, 8.0});
+    std::vector<std::string> order;
+    while (!f.empty()) order.push_back(f.pop().url);
+    std::vector<std::string> expected = {"top", "high", "high2", "deep", "low"};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(CrawlFrontier, SpillsToDiskAndKeepsOrder) {
+    std::string dir = fresh_temp_dir("frontier_spill");
+    CrawlFrontier f(CrawlFrontier::Options{true, kBudget, dir});
+    for (int i = 0; i < 5000; ++i) {
+        f.push(numbered(i));
+        ASSERT_LE(f.in_memory(), kMemoryBound);
+    }
+    EXPECT_EQ(f.size(), 5000u);
+    double last_score = 1e9;
+    int last_depth = -1;
+    int last_index = -1;
+    int popped = 0;
+    while (!f.empty()) {
+        auto e = f.pop();
+        ASSERT_LE(f.in_memory(), kMemoryBound);
+        if (e.url[0] == 'x') {  // pushed while draining, checked below
+            ++popped;
+            continue;
+        }
+        int index = std::stoi(e.url.substr(1));
+        ASSERT_LE(e.score, last_score);
+        if (e.score == last_score) {
+            ASSERT_GE(e.depth, last_depth);
+            if (e.depth == last_depth) {
+                ASSERT_GT(index, last_index);  // FIFO within a bucket
+            }
+        }
+        last_score = e.score;
+        last_depth = e.depth;
+        last_index = index;
+        ++popped;
+        if (popped % 100 == 0) f.push({"x" + std::to_string(popped), 9, 0, -1.0});  // lowest priority
+    }
+    EXPECT_GE(popped, 5000);
+}
+
+TEST(CrawlFrontier, KeepsEntriesInMemoryWhenSpillFails) {
+    std::string dir = fresh_temp_dir("frontier_spill_fail");
+    std::string moved = dir + ".moved";
+    fs::remove_all(moved);
+    CrawlFrontier f(CrawlFrontier::Options{true, kBudget, dir});
+    for (int i = 0; i < 1000; ++i) f.push(numbered(i));
+    ASSERT_LE(f.in_memory(), kMemoryBound);
+
+    // A regular file where the spill directory was makes every later segment write fail.
+    fs::rename(dir, moved);
+    std::ofstream(dir) << "not a directory";
+    for (int i = 1000; i < 2000; ++i) {
+        f.push(numbered(i));
+        ASSERT_LE(f.in_memory(), kMemoryBound + (i - 999));  // only what failed to spill is added
+    }
+    EXPECT_EQ(f.size(), 2000u);
+    EXPECT_GT(f.in_memory(), kMemoryBound);
+
+    // Segments written before the failure are still read back; nothing is dropped.
+    fs::remove(dir);
+    fs::rename(moved, dir);
+    auto indices = drain_in_order(f);
+    EXPECT_EQ(indices.size(), 2000u);
+    EXPECT_EQ(std::set<int>(indices.begin(), indices.end()).size(), 2000u);
+    EXPECT_EQ(f.in_memory(), 0u);
+}
+
+TEST(CrawlFrontier, ContinuousScoresShareBuckets) {
+    std::string dir = fresh_temp_dir("frontier_continuous");
+    CrawlFrontier f(CrawlFrontier::Options{true, kBudget, dir});
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> model(-3.0, 3.0);
+    for (int i = 0; i < 5000; ++i) {
+        // Keyword score plus a model term, as the crawler scores links: almost never equal.
+        f.push({"u" + std::to_string(i), 1 + i % 2, 0, static_cast<double>(i % 3) + model(rng)});
+        ASSERT_LE(f.in_memory(), kMemoryBound);
+    }
+    // Rounded scores span -3..5 over two depths.
+    EXPECT_LE(f.buckets(), 18u);
+    size_t segments = 0;
+    for (const auto& e : fs::directory_iterator(dir)) segments += e.path().extension() == ".seg";
+    EXPECT_LE(segments, 2 * 5000 / (kBudget / 8));
+
+    double last = 1e9;
+    while (!f.empty()) {
+        double score = std::round(f.pop().score);
+        ASSERT_LE(score, last);
+        last = score;
+    }
+}
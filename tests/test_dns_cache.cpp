@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/dns_cache.hpp"
+#include "scrape_llm/ssrf_guard.hpp"
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+
+using scrapellm::DnsCache;
+using scrapellm::first_private_address;
+
+namespace {
+
+// .invalid never resolves (RFC 6761), so the resolver fails without a network round trip.
+const char* kMissing = "nonexistent.invalid";
+
+// try_resolve until the background lookup it started has finished.
+DnsCache::Result await(DnsCache& dns, const std::string& host) {
+    for (int i = 0; i < 500; ++i) {
+        if (auto r = dns.try_resolve(host)) return *r;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ADD_FAILURE() << "lookup of " << host << " never finished";
+    return {};
+}
+
+} // namespace
+
+TEST(DnsCache, ResolvesLiterals) {
+    DnsCache dns(DnsCache::Options{});
+    auto v4 = dns.resolve("93.184.216.34");
+    ASSERT_TRUE(v4.ok());
+    EXPECT_EQ(v4.addresses, std::vector<std::string>{"93.184.216.34"});
+    auto v6 = dns.resolve("[2001:db8::1]");  // bracketed as in URLs
+    if (v6.ok()) {  // AI_ADDRCONFIG drops it on hosts without IPv6
+        EXPECT_EQ(v6.addresses, std::vector<std::string>{"2001:db8::1"});
+    }
+}
+
+TEST(DnsCache, SuccessIsCachedForTtl) {
+    DnsCache kept(DnsCache::Options{std::chrono::seconds(3600), std::chrono::seconds(0)});
+    ASSERT_TRUE(kept.resolve("127.0.0.1").ok());
+    auto cached = kept.try_resolve("127.0.0.1");
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_TRUE(cached->ok());
+
+    // With a zero ttl the entry is stale at once, so the next non-blocking call looks it up again.
+    DnsCache expiring(DnsCache::Options{std::chrono::seconds(0), std::chrono::seconds(3600)});
+    ASSERT_TRUE(expiring.resolve("127.0.0.1").ok());
+    EXPECT_FALSE(expiring.try_resolve("127.0.0.1").has_value());
+}
+
+TEST(DnsCache, FailureIsCachedForNegativeTtl) {
+    DnsCache kept(DnsCache::Options{std::chrono::seconds(0), std::chrono::seconds(3600)});
+    auto failed = kept.resolve(kMissing);
+    EXPECT_FALSE(failed.ok());
+    EXPECT_FALSE(failed.error.empty());
+    auto cached = kept.try_resolve(kMissing);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_FALSE(cached->ok());
+
+    DnsCache expiring(DnsCache::Options{std::chrono::seconds(3600), std::chrono::seconds(0)});
+    EXPECT_FALSE(expiring.resolve(kMissing).ok());
+    EXPECT_FALSE(expiring.try_resolve(kMissing).has_value());
+}
+
+TEST(DnsCache, TryResolveStartsLookupInBackground) {
+    DnsCache dns(DnsCache::Options{});
+    EXPECT_FALSE(dns.try_resolve("127.0.0.2").has_value());
+    auto r = await(dns, "127.0.0.2");
+    ASSERT_TRUE(r.ok());
+    EXPECT_EQ(r.addresses.front(), "127.0.0.2");
+    EXPECT_FALSE(await(dns, kMissing).ok());
+}
+
+TEST(DnsCache, AnyPrivateAddressRefusesHost) {
+    EXPECT_EQ(first_private_address({"93.184.216.34", "2606:2800:220:1::1"}), "");
+    EXPECT_EQ(first_private_address({"93.184.216.34", "10.0.0.7"}), "10.0.0.7");
+    EXPECT_EQ(first_private_address({"::ffff:192.168.1.1", "93.184.216.34"}), "::ffff:192.168.1.1");
+    EXPECT_EQ(first_private_address({}), "");
+
+    DnsCache dns(DnsCache::Options{});
+    auto local = dns.resolve("localhost");
+    ASSERT_TRUE(local.ok());
+    EXPECT_FALSE(first_private_address(local.addresses).empty());
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include "scrape_llm/link_scorer.hpp"
+#include <filesystem>
+#include <string>
+
+namespace scrapellm::testutil {
+
+// An empty directory under gtest's temp dir, cleared of anything a previous run left behind.
+inline std::string fresh_temp_dir(const std::string& name) {
+    std::string dir = ::testing::TempDir() + "scrape_llm_" + name;
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+inline LinkContext anchor_link(const std::string& url, const std::string& anchor = "", const std::string& rel = "") {
+    LinkContext l;
+    l.url = url;
+    l.anchor = anchor;
+    l.rel = rel;
+    return l;
+}
+
+} // namespace scrapellm::testutil
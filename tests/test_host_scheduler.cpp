@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "fetch/host_scheduler.hpp"
+#include "fetch/rate_limiter.hpp"
+
+using docscraper::fetch::HostScheduler;
+using docscraper::fetch::RateLimiter;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+using Clock = std::chrono::steady_clock;
+
+TEST(RateLimiterReserve, SpacesSuccessiveSlotsByTheDelay) {
+    RateLimiter limiter(milliseconds(1000));
+    auto before = Clock::now();
+    auto first = limiter.reserve("a.com");
+    auto after = Clock::now();
+    EXPECT_GE(first, before);
+    EXPECT_LE(first, after);  // nothing reserved yet: due now
+    auto prev = first;
+    for (int i = 0; i < 20; ++i) {
+        auto slot = limiter.reserve("a.com");
+        EXPECT_GE(slot - prev, milliseconds(900));   // 1000 ms minus up to 10% jitter
+        EXPECT_LE(slot - prev, milliseconds(1100));
+        prev = slot;
+    }
+    auto other = limiter.reserve("b.com");
+    EXPECT_LE(other, Clock::now());  // hosts are paced independently
+}
+
+TEST(RateLimiterReserve, EarliestMatchesNextReserve) {
+    RateLimiter limiter(milliseconds(1000));
+    for (int i = 0; i < 20; ++i) {
+        auto predicted = limiter.earliest("a.com");
+        auto slot = limiter.reserve("a.com");
+        if (i > 0) {
+            EXPECT_EQ(predicted, slot) << i;  // jitter was drawn by the previous reserve
+        }
+    }
+}
+
+TEST(RateLimiterReserve, RetryAfterDelaysTheNextSlot) {
+    RateLimiter limiter(milliseconds(100));
+    auto before = Clock::now();
+    limiter.reserve("a.com");
+    limiter.record_response("a.com", 429, milliseconds(5), seconds(20));
+    EXPECT_GE(limiter.reserve("a.com"), before + seconds(20));
+}
+
+TEST(HostScheduler, PopsDueHostsInFifoOrder) {
+    RateLimiter limiter(milliseconds(1000));
+    HostScheduler scheduler(limiter);
+    EXPECT_FALSE(scheduler.next_ready().has_value());
+    for (const char* host : {"c.com", "a.com", "b.com"}) scheduler.push(host);
+    scheduler.push("a.com");  // already scheduled
+    EXPECT_EQ(scheduler.size(), 3u);
+
+    auto now = Clock::now();
+    EXPECT_EQ(scheduler.pop_ready(now), "c.com");
+    EXPECT_EQ(scheduler.pop_ready(now), "a.com");
+    EXPECT_EQ(scheduler.pop_ready(now), "b.com");
+    EXPECT_FALSE(scheduler.pop_ready(now).has_value());
+    EXPECT_TRUE(scheduler.empty());
+}
+
+TEST(HostScheduler, OrdersHostsByTheirNextSlot) {
+    RateLimiter limiter(milliseconds(1000));
+    HostScheduler scheduler(limiter);
+    auto busy_slot = limiter.reserve("busy.com");  // next slot about a second out
+    scheduler.push("busy.com");
+    scheduler.push("idle.com");
+
+    auto now = Clock::now();
+    EXPECT_EQ(scheduler.pop_ready(now), "idle.com");
+    EXPECT_FALSE(scheduler.pop_ready(now).has_value());
+    ASSERT_TRUE(scheduler.next_ready().has_value());
+    EXPECT_EQ(*scheduler.next_ready(), limiter.earliest("busy.com"));
+    EXPECT_GT(*scheduler.next_ready(), busy_slot);
+    EXPECT_EQ(scheduler.pop_ready(*scheduler.next_ready()), "busy.com");
+}
+
+TEST(HostScheduler, RequeuesHostWhoseSlotMovedLater) {
+    RateLimiter limiter(milliseconds(0));
+    HostScheduler scheduler(limiter);
+    scheduler.push("a.com");
+    scheduler.push("b.com");
+    limiter.record_response("a.com", 503, milliseconds(5), seconds(30));  // after a.com was pushed
+
+    auto now = Clock::now();
+    EXPECT_EQ(scheduler.pop_ready(now), "b.com");
+    EXPECT_FALSE(scheduler.pop_ready(now).has_value());
+    EXPECT_EQ(scheduler.size(), 1u);
+    ASSERT_TRUE(scheduler.next_ready().has_value());
+    EXPECT_GE(*scheduler.next_ready(), now + seconds(29));
+    EXPECT_FALSE(scheduler.pop_ready(now + seconds(10)).has_value());
+    EXPECT_EQ(scheduler.pop_ready(now + seconds(31)), "a.com");
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/incremental_store.hpp"
+#include "test_helpers.hpp"
+
+using namespace scrapellm;
+using scrapellm::testutil::fresh_temp_dir;
+
+namespace {
+
+ExtractedContent page(const std::string& text) {
+    ExtractedContent c;
+    c.url = "https://example.com/p/1";
+    c.title = "Widget";
+    c.main_text = text;
+    return c;
+}
+
+} // namespace
+
+TEST(IncrementalStore, ContentHashFollowsExtractedContent) {
+    EXPECT_EQ(IncrementalStore::content_hash(page("Price: 10")), IncrementalStore::content_hash(page("Price: 10")));
+    EXPECT_NE(IncrementalStore::content_hash(page("Price: 10")), IncrementalStore::content_hash(page("Price: 12")));
+    ExtractedContent with_table = page("Price: 10");
+    with_table.tables_tsv.push_back("size\tM\n");
+    EXPECT_NE(IncrementalStore::content_hash(with_table), IncrementalStore::content_hash(page("Price: 10")));
+}
+
+TEST(IncrementalStore, ReusesUnchangedPagesAcrossRuns) {
+    std::string dir = fresh_temp_dir("incremental");
+    std::string kept_hash = IncrementalStore::content_hash(page("Price: 10"));
+    std::string skipped_hash = IncrementalStore::content_hash(page("About us"));
+    {
+        IncrementalStore store(dir, "schema-1");
+        EXPECT_EQ(store.load(), 0u);
+        store.record_relevance("https://example.com/p/1", kept_hash, RelevanceDecision{true, "product", false});
+        ParsedPage parsed;
+        parsed.records.push_back({{"name", "Widget"}, {"price", 10}});
+        store.record_parsed("https://example.com/p/1", kept_hash, parsed);
+        store.record_relevance("https://example.com/about", skipped_hash, RelevanceDecision{false, "not a product", false});
+        ASSERT_TRUE(store.save());
+    }
+
+    IncrementalStore store(dir, "schema-1");
+    EXPECT_EQ(store.load(), 2u);
+    const IncrementalStore::Entry* kept = store.unchanged("https://example.com/p/1", kept_hash);
+    ASSERT_NE(kept, nullptr);
+    EXPECT_TRUE(kept->decision.keep);
+    ASSERT_TRUE(kept->parsed);
+    ASSERT_EQ(kept->page.records.size(), 1u);
+    EXPECT_EQ(kept->page.records[0]["price"], 10);
+    const IncrementalStore::Entry* skipped = store.unchanged("https://example.com/about", skipped_hash);
+    ASSERT_NE(skipped, nullptr);
+    EXPECT_FALSE(skipped->decision.keep);
+
+    // Changed content misses.
+    EXPECT_EQ(store.unchanged("https://example.com/p/1", IncrementalStore::content_hash(page("Price: 12"))), nullptr);
+
+    // A different schema starts over.
+    IncrementalStore other(dir, "schema-2");
+    EXPECT_EQ(other.load(), 0u);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/link_classifier.hpp"
+#include "test_helpers.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace scrapellm;
+using scrapellm::testutil::anchor_link;
+using scrapellm::testutil::fresh_temp_dir;
+
+namespace {
+
+void train(LinkClassifier& model, int rounds) {
+    for (int i = 0; i < rounds; ++i) {
+        std::string n = std::to_string(100 + i);
+        model.update("https://shop.example.com/product/" + n, "Steel widget " + n + " - price and specs", true);
+        model.update("https://shop.example.com/blog/company-news-" + n, "Company news: our team at the expo", false);
+    }
+}
+
+} // namespace
+
+TEST(LinkClassifier, NeutralUntilTrainedOnBothClasses) {
+    LinkClassifier model(fresh_temp_dir("link_model_neutral"), "k");
+    for (int i = 0; i < 10; ++i) model.update("https://example.com/product/" + std::to_string(i), "Widget", true);
+    EXPECT_FALSE(model.ready());
+    EXPECT_DOUBLE_EQ(model.predict(anchor_link("https://example.com/product/99", "Widget")), 0.5);
+}
+
+TEST(LinkClassifier, LearnsWhichLinksLeadToKeptPages) {
+    LinkClassifier model(fresh_temp_dir("link_model_learn"), "k");
+    train(model, 30);
+    ASSERT_TRUE(model.ready());
+    double product = model.predict(anchor_link("https://shop.example.com/product/999", "Copper widget"));
+    double blog = model.predict(anchor_link("https://shop.example.com/blog/summer-party", "Our team"));
+    EXPECT_GT(product, 0.8);
+    EXPECT_LT(blog, 0.3);
+}
+
+TEST(LinkClassifier, PersistsPerSchemaKey) {
+    std::string dir = fresh_temp_dir("link_model_persist");
+    LinkContext product = anchor_link("https://shop.example.com/product/999", "Copper widget");
+    double trained = 0.0;
+    {
+        LinkClassifier model(dir, "schema-a");
+        train(model, 20);
+        trained = model.predict(product);
+        ASSERT_TRUE(model.save());
+    }
+    LinkClassifier same(dir, "schema-a");
+    EXPECT_EQ(same.load(), 40);
+    EXPECT_NEAR(same.predict(product), trained, 1e-4);
+
+    LinkClassifier other(dir, "schema-b");
+    EXPECT_EQ(other.load(), 0);
+    EXPECT_FALSE(other.ready());
+}
+
+TEST(LinkClassifier, MalformedFileStartsUntrained) {
+    std::string dir = fresh_temp_dir("link_model_malformed");
+    std::filesystem::create_directories(dir + "/cache");
+    // Entries of the wrong type are skipped; counters of the wrong type discard the whole file.
+    std::ofstream(dir + "/cache/link_model.json")
+        << R"({"version": 1, "schema_key": "k", "kept": 30, "skipped": 30,)"
+        << R"( "weights": [["7", 1.0], [-3, 1.0], [5, "big"], [9]]})";
+    LinkClassifier skipped(dir, "k");
+    EXPECT_EQ(skipped.load(), 60);
+    EXPECT_DOUBLE_EQ(skipped.predict(anchor_link("https://example.com/product/1", "Widget")), 0.5);
+
+    std::ofstream(dir + "/cache/link_model.json")
+        << R"({"version": 1, "schema_key": "k", "kept": "many", "skipped": 30, "weights": []})";
+    LinkClassifier corrupt(dir, "k");
+    EXPECT_EQ(corrupt.load(), 0);
+    EXPECT_FALSE(corrupt.ready());
+
+    std::ofstream(dir + "/cache/link_model.json") << R"({"version": "1", "schema_key": "k"})";
+    LinkClassifier wrong_version(dir, "k");
+    EXPECT_EQ(wrong_version.load(), 0);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/link_graph.hpp"
+#include "scrape_llm/llm_client.hpp"
+#include "scrape_llm/relevance_router.hpp"
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+using namespace scrapellm;
+
+namespace {
+
+// Relevance client that keeps every page.
+class KeepAll : public ILlmClient {
+public:
+    std::optional<std::string> chat(const std::string&, const std::string&) override {
+        return R"({"decision":"KEEP","reason":"ok"})";
+    }
+};
+
+} // namespace
+
+TEST(LinkGraph, CountsDistinctLinksFromCrawledPages) {
+    LinkGraph graph;
+    graph.add_page("https://a.test/", {"https://a.test/x", "https://a.test/x", "https://a.test/", "https://a.test/y"});
+    graph.add_page("https://a.test/y", {"https://a.test/x"});
+    graph.add_page("https://a.test/", {"https://a.test/z"});  // recorded already
+
+    EXPECT_EQ(graph.pages(), 2u);
+    EXPECT_EQ(graph.nodes(), 3u);
+    EXPECT_EQ(graph.edges(), 3u);
+    EXPECT_EQ(graph.in_degree("https://a.test/x"), 2u);
+    EXPECT_EQ(graph.in_degree("https://a.test/y"), 1u);
+    EXPECT_EQ(graph.in_degree("https://a.test/"), 0u);
+    EXPECT_EQ(graph.in_degree("https://a.test/z"), 0u);
+    EXPECT_FALSE(graph.find("https://a.test/z").has_value());
+}
+
+TEST(LinkGraph, PageRankFavorsLinkedPages) {
+    LinkGraph graph;
+    graph.add_page("https://a.test/", {"https://a.test/hub", "https://a.test/leaf"});
+    graph.add_page("https://a.test/p1", {"https://a.test/hub"});
+    graph.add_page("https://a.test/p2", {"https://a.test/hub"});
+    graph.add_page("https://a.test/hub", {"https://a.test/"});
+
+    std::vector<double> rank = graph.pagerank();
+    ASSERT_EQ(rank.size(), graph.nodes());
+    EXPECT_NEAR(std::accumulate(rank.begin(), rank.end(), 0.0), 1.0, 1e-9);
+    double hub = rank[*graph.find("https://a.test/hub")];
+    double leaf = rank[*graph.find("https://a.test/leaf")];
+    double p1 = rank[*graph.find("https://a.test/p1")];
+    EXPECT_GT(hub, leaf);
+    EXPECT_GT(leaf, p1);
+}
+
+TEST(LinkGraph, WritesTsv) {
+    auto dir = std::filesystem::temp_directory_path() / "scrape_llm_link_graph";
+    std::filesystem::remove_all(dir);
+    LinkGraph graph;
+    graph.add_page("https://a.test/", {"https://a.test/x"});
+    ASSERT_TRUE(graph.write_tsv(dir.string()));
+
+    std::ifstream nodes(dir / "nodes.tsv");
+    std::string header, root, x;
+    std::getline(nodes, header);
+    std::getline(nodes, root);
+    std::getline(nodes, x);
+    EXPECT_EQ(header, "id\turl\tcrawled\tin_degree\tout_degree\tpagerank");
+    EXPECT_EQ(root.rfind("0\thttps://a.test/\t1\t0\t1\t", 0), 0u);
+    EXPECT_EQ(x.rfind("1\thttps://a.test/x\t0\t1\t0\t", 0), 0u);
+
+    std::ifstream edges(dir / "edges.tsv");
+    std::string line;
+    std::getline(edges, line);
+    std::getline(edges, line);
+    EXPECT_EQ(line, "0\t1");
+}
+
+TEST(LinkGraph, RankBreaksTiesBetweenKeptPages) {
+    std::vector<PageDigest> digests(3);
+    digests[0].url = "https://a.test/first";
+    digests[1].url = "https://a.test/linked";
+    digests[1].rank = 0.5;
+    digests[2].url = "https://a.test/third";
+    KeepAll llm;
+    auto kept = select_pages_to_parse(llm, "items", digests, 2);
+    ASSERT_EQ(kept.size(), 2u);
+    EXPECT_EQ(kept[0].url, "https://a.test/linked");
+    EXPECT_EQ(kept[1].url, "https://a.test/first");
+}
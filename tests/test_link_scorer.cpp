@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/link_scorer.hpp"
+
+using scrapellm::InferredSchema;
+using scrapellm::LinkContext;
+using scrapellm::LinkScorer;
+
+static LinkScorer product_scorer() {
+    InferredSchema schema;
+    schema.json_schema = {{"type", "array"},
+                          {"items", {{"type", "object"},
+                                     {"properties", {{"productName", {{"type", "string"}}},
+                                                     {"unit_price", {{"type", "number"}}}}}}}};
+    schema.hints = {{"key_fields", {"sku"}}};
+    return LinkScorer("Extract all products with their price and rating", schema);
+}
+
+TEST(LinkScorer, TokenizeSplitsAndSingularizes) {
+    auto t = LinkScorer::tokenize("Extract productName, unit_price and Categories from /shop/items-2024.html");
+    std::vector<std::string> expected = {"product", "name", "unit", "price", "category", "shop", "item"};
+    EXPECT_EQ(t, expected);
+}
+
+TEST(LinkScorer, KeywordsFromDescriptionHintsAndProperties) {
+    auto s = product_scorer();
+    for (const char* k : {"product", "price", "rating", "sku", "name", "unit"})
+        EXPECT_TRUE(s.keywords().count(k)) << k;
+    EXPECT_FALSE(s.keywords().count("extract"));
+    EXPECT_FALSE(s.keywords().count("string"));
+}
+
+TEST(LinkScorer, RelevantLinksOutscoreBoilerplate) {
+    auto s = product_scorer();
+    double product = s.score({"https://shop.example/products/widget", "Widget product page", "Products", 0.0});
+    double category = s.score({"https://shop.example/c/tools", "Tools", "Browse products", 0.0});
+    double plain = s.score({"https://shop.example/team", "Our team", "", 0.0});
+    double legal = s.score({"https://shop.example/privacy-policy", "Privacy", "", 0.0});
+    EXPECT_GT(product, category);
+    EXPECT_GT(category, plain);
+    EXPECT_GT(plain, legal);
+    EXPECT_EQ(LinkScorer().score({"https://shop.example/products", "Products", "", 0.0}), 0.0);
+}
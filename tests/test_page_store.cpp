@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/page_store.hpp"
+#include "test_helpers.hpp"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using scrapellm::PageStore;
+using scrapellm::testutil::fresh_temp_dir;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Incompressible payload, so record sizes are predictable.
+std::string noise(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::string s(n, '\0');
+    for (auto& c : s) c = static_cast<char>(rng() & 0xff);
+    return s;
+}
+
+std::string key(int i) {
+    return "https://example.com/p/" + std::to_string(i);
+}
+
+std::string only_segment(const std::string& dir) {
+    std::string found;
+    for (const auto& e : fs::directory_iterator(dir))
+        if (e.path().extension() == ".pack") {
+            EXPECT_TRUE(found.empty());
+            found = e.path().string();
+        }
+    return found;
+}
+
+} // namespace
+
+TEST(PageStore, RoundTripsAndPersists) {
+    std::string dir = fresh_temp_dir("page_store_roundtrip");
+    std::string html(5000, 'x');
+    {
+        PageStore store(PageStore::Options{dir});
+        ASSERT_TRUE(store.put(key(1), html));
+        ASSERT_TRUE(store.put(key(2), "<p>two</p>"));
+        ASSERT_TRUE(store.put(key(2), "<p>two, again</p>"));
+        EXPECT_EQ(store.get(key(1)), html);
+        EXPECT_FALSE(store.get(key(3)).has_value());
+        EXPECT_LT(store.stats().file_bytes, html.size());  // compressed
+    }
+    PageStore store(PageStore::Options{dir});
+    EXPECT_EQ(store.stats().entries, 2u);
+    EXPECT_EQ(store.get(key(1)), html);
+    EXPECT_EQ(store.get(key(2)), "<p>two, again</p>");
+}
+
+TEST(PageStore, CrcMismatchReadsAsMiss) {
+    std::string dir = fresh_temp_dir("page_store_crc");
+    {
+        PageStore store(PageStore::Options{dir});
+        ASSERT_TRUE(store.put(key(1), noise(1000, 1)));
+    }
+    {
+        std::fstream f(only_segment(dir), std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(500);
+        f.put('\x5a');
+    }
+    PageStore store(PageStore::Options{dir});
+    EXPECT_TRUE(store.contains(key(1)));
+    EXPECT_FALSE(store.get(key(1)).has_value());
+}
+
+TEST(PageStore, RebuildsIndexByRescanningSegments) {
+    std::string dir = fresh_temp_dir("page_store_rescan");
+    {
+        PageStore store(PageStore::Options{dir});
+        for (int i = 0; i < 20; ++i) ASSERT_TRUE(store.put(key(i), noise(300, i)));
+        ASSERT_TRUE(store.put(key(3), "replaced"));
+    }
+    fs::remove(dir + "/index.bin");
+    PageStore store(PageStore::Options{dir});
+    EXPECT_EQ(store.stats().entries, 20u);
+    EXPECT_EQ(store.get(key(3)), "replaced");
+    EXPECT_EQ(store.get(key(19)), noise(300, 19));
+}
+
+TEST(PageStore, TruncatesTornTailOnReopen) {
+    std::string dir = fresh_temp_dir("page_store_torn");
+    uint64_t intact = 0;
+    {
+        PageStore store(PageStore::Options{dir});
+        ASSERT_TRUE(store.put(key(1), noise(400, 1)));
+        ASSERT_TRUE(store.put(key(2), noise(400, 2)));
+        intact = store.stats().file_bytes;
+        ASSERT_TRUE(store.put(key(3), noise(400, 3)));
+    }
+    // Cut the last record short, as a crash mid-append would, and lose the snapshot with it.
+    std::string seg = only_segment(dir);
+    fs::resize_file(seg, fs::file_size(seg) - 100);
+    fs::remove(dir + "/index.bin");
+
+    PageStore store(PageStore::Options{dir});
+    EXPECT_EQ(fs::file_size(seg), intact);
+    EXPECT_EQ(store.stats().entries, 2u);
+    EXPECT_EQ(store.get(key(2)), noise(400, 2));
+    EXPECT_FALSE(store.contains(key(3)));
+    ASSERT_TRUE(store.put(key(3), "rewritten"));
+    EXPECT_EQ(store.get(key(3)), "rewritten");
+}
+
+TEST(PageStore, EvictsLeastRecentlyUsedToBudget) {
+    std::string dir = fresh_temp_dir("page_store_lru");
+    PageStore store(PageStore::Options{dir, 20000});
+    for (int i = 0; i < 4; ++i) ASSERT_TRUE(store.put(key(i), noise(4000, i)));
+    ASSERT_TRUE(store.get(key(0)).has_value());  // key 0 is now more recent than 1..3
+    for (int i = 4; i < 6; ++i) ASSERT_TRUE(store.put(key(i), noise(4000, i)));
+
+    auto s = store.stats();
+    EXPECT_LE(s.live_bytes, 20000u);
+    EXPECT_EQ(s.entries, 4u);
+    EXPECT_TRUE(store.contains(key(0)));
+    EXPECT_FALSE(store.contains(key(1)));
+    EXPECT_FALSE(store.contains(key(2)));
+    EXPECT_TRUE(store.contains(key(5)));
+}
+
+TEST(PageStore, EvictedPagesStayGoneAfterIndexLoss) {
+    std::string dir = fresh_temp_dir("page_store_tombstone");
+    size_t entries = 0;
+    {
+        PageStore store(PageStore::Options{dir, 20000});
+        for (int i = 0; i < 8; ++i) ASSERT_TRUE(store.put(key(i), noise(4000, i)));
+        ASSERT_FALSE(store.contains(key(0)));
+        entries = store.stats().entries;
+    }
+    fs::remove(dir + "/index.bin");
+    PageStore store(PageStore::Options{dir, 20000});
+    EXPECT_EQ(store.stats().entries, entries);
+    EXPECT_FALSE(store.contains(key(0)));
+    EXPECT_FALSE(store.get(key(0)).has_value());
+    EXPECT_TRUE(store.contains(key(7)));
+}
+
+TEST(PageStore, CompactsMostlyDeadSegments) {
+    std::string dir = fresh_temp_dir("page_store_compact");
+    PageStore::Options options{dir, 20000, 10000};
+    {
+        PageStore store(options);
+        for (int i = 0; i < 60; ++i) ASSERT_TRUE(store.put(key(i), noise(3000, i)));
+        auto s = store.stats();
+        EXPECT_LE(s.live_bytes, 20000u);
+        // Without compaction all 60 pages (~180 KB in ~20 segments) would still be on disk.
+        EXPECT_LT(s.file_bytes, 3 * options.max_bytes);
+        EXPECT_LT(s.segments, 8u);
+        EXPECT_EQ(store.get(key(59)), noise(3000, 59));
+    }
+    // Compaction carried live records and tombstones over, so a rescan sees the same pages.
+    fs::remove(dir + "/index.bin");
+    PageStore store(options);
+    for (int i = 0; i < 60; ++i) {
+        auto page = store.get(key(i));
+        if (page) {
+            EXPECT_EQ(*page, noise(3000, i)) << i;
+        }
+    }
+    EXPECT_LE(store.stats().live_bytes, 20000u);
+    EXPECT_TRUE(store.contains(key(59)));
+    EXPECT_FALSE(store.contains(key(0)));
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/crawl_frontier.hpp"
+#include "scrape_llm/pagination.hpp"
+#include "test_helpers.hpp"
+
+using namespace scrapellm;
+using scrapellm::testutil::anchor_link;
+
+TEST(Pagination, ReadsPageNumbers) {
+    EXPECT_EQ(url_page_number("https://shop.example.com/list?page=3"), 3);
+    EXPECT_EQ(url_page_number("https://shop.example.com/list?sort=price&p=12"), 12);
+    EXPECT_EQ(url_page_number("https://example.com/blog/page/4/"), 4);
+    EXPECT_EQ(url_page_number("https://example.com/list"), -1);
+    EXPECT_EQ(url_page_number("https://example.com/product/123456"), -1);
+}
+
+TEST(Pagination, FollowsLaterPagesOfTheSameListing) {
+    std::string page = "https://shop.example.com/list?sort=price&page=2";
+    EXPECT_TRUE(is_pagination_link(anchor_link("https://shop.example.com/list?page=3&sort=price", "3"), page));
+    EXPECT_FALSE(is_pagination_link(anchor_link("https://shop.example.com/list?page=1&sort=price", "1"), page));
+    EXPECT_FALSE(is_pagination_link(anchor_link("https://shop.example.com/list?page=3&sort=name", "3"), page));
+    EXPECT_FALSE(is_pagination_link(anchor_link("https://shop.example.com/product/77", "Blue widget"), page));
+
+    EXPECT_TRUE(is_pagination_link(anchor_link("https://example.com/blog/page/2", "2"), "https://example.com/blog"));
+}
+
+TEST(Pagination, RecognisesRelNextAndNextAnchors) {
+    std::string page = "https://example.com/search?q=shoes";
+    EXPECT_TRUE(is_pagination_link(anchor_link("https://example.com/search?q=shoes&cursor=abc", "", "next"), page));
+    EXPECT_TRUE(is_pagination_link(anchor_link("https://example.com/search?q=shoes&cursor=abc", "Next »"), page));
+    EXPECT_TRUE(is_pagination_link(anchor_link("https://example.com/search?q=shoes&cursor=abc", "›"), page));
+    EXPECT_FALSE(is_pagination_link(anchor_link("https://example.com/search?q=shoes&cursor=xyz", "« Previous"), page));
+    EXPECT_FALSE(is_pagination_link(anchor_link("https://example.com/articles/next-steps", "Next"), page));
+}
+
+TEST(Pagination, CanonicalToPageOneDoesNotCollapseLaterPages) {
+    std::string first = "https://shop.example.com/list?sort=price";
+    // Reached through a pagination link: never merged, whatever the canonical says.
+    EXPECT_FALSE(canonical_applies(first, "https://shop.example.com/list?sort=price&page=2", 1));
+    EXPECT_FALSE(canonical_applies(first, "https://shop.example.com/offers", 1));
+    // Reached by an ordinary link: still not merged into another page of the same listing.
+    EXPECT_FALSE(canonical_applies(first, "https://shop.example.com/list?sort=price&page=2", 0));
+    EXPECT_FALSE(canonical_applies("https://example.com/blog", "https://example.com/blog/page/3", 0));
+
+    EXPECT_TRUE(canonical_applies(first, "https://shop.example.com/list?page=1&sort=price", 0));
+    EXPECT_TRUE(canonical_applies(first, "https://shop.example.com/list?sort=price&utm_source=x", 0));
+    EXPECT_TRUE(canonical_applies("https://shop.example.com/product/7", "https://shop.example.com/list?page=2", 0));
+}
+
+TEST(Pagination, FrontierPopsPaginationFirstInBfsOrder) {
+    CrawlFrontier frontier(CrawlFrontier::Options{});
+    frontier.push({"https://example.com/a", 1, 0, 0.0});
+    frontier.push({"https://example.com/list?page=2", 1, 0, 1e6, 1});
+    frontier.push({"https://example.com/b", 0, 0, 0.0});
+    EXPECT_EQ(frontier.pop().url, "https://example.com/list?page=2");
+    EXPECT_EQ(frontier.pop().url, "https://example.com/b");
+    EXPECT_EQ(frontier.pop().url, "https://example.com/a");
+}
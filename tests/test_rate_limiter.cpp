@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "fetch/rate_limiter.hpp"
+
+using docscraper::fetch::AdaptiveRateOptions;
+using docscraper::fetch::RateLimiter;
+using docscraper::fetch::parse_retry_after;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+// Adaptive limiters below start at 1 req/s (1000 ms) and are bounded to 100 ms .. 60 s.
+
+TEST(RateLimiter, FixedModeIgnoresResponses) {
+    RateLimiter limiter(milliseconds(500));
+    EXPECT_FALSE(limiter.adaptive());
+    limiter.record_response("a.com", 503, milliseconds(100));
+    limiter.record_response("a.com", 200, milliseconds(100));
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(500));
+    limiter.set_host_delay("a.com", milliseconds(2000));
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(2000));
+    EXPECT_EQ(limiter.get_host_delay("b.com"), milliseconds(500));
+}
+
+TEST(RateLimiter, HealthyResponsesIncreaseRateAdditively) {
+    RateLimiter limiter(milliseconds(1000));
+    limiter.enable_adaptive(AdaptiveRateOptions{});
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(1000));
+    limiter.record_response("a.com", 200, milliseconds(100));  // 1.2 req/s
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(833));
+    limiter.record_response("a.com", 404, milliseconds(100));  // 4xx other than 429 is healthy
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(714));
+    EXPECT_EQ(limiter.get_host_delay("b.com"), milliseconds(1000));
+}
+
+TEST(RateLimiter, ErrorsHalveTheRate) {
+    for (int status : {429, 500, 503, 0}) {
+        RateLimiter limiter(milliseconds(1000));
+        limiter.enable_adaptive(AdaptiveRateOptions{});
+        limiter.record_response("a.com", 200, milliseconds(100));  // 1.2 req/s
+        limiter.record_response("a.com", status, milliseconds(100));  // 0.6 req/s
+        EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(1666)) << status;
+    }
+}
+
+TEST(RateLimiter, LatencySpikeBacksOffOnlyAfterThreeSamples) {
+    RateLimiter limiter(milliseconds(1000));
+    limiter.enable_adaptive(AdaptiveRateOptions{});
+    limiter.record_response("a.com", 200, milliseconds(100));   // 1.2, baseline 100
+    limiter.record_response("a.com", 200, milliseconds(100));   // 1.4, baseline 100
+    limiter.record_response("a.com", 200, milliseconds(1000));  // 2 samples: no spike yet -> 1.6, baseline 190
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(625));
+    limiter.record_response("a.com", 200, milliseconds(1000));  // 1000 > 2 x 190: x0.8 -> 1.28
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(781));
+    limiter.record_response("a.com", 200, milliseconds(300));   // under 2 x baseline: +0.2 -> 1.48
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(675));
+}
+
+TEST(RateLimiter, ClampsToMinAndMaxDelay) {
+    RateLimiter limiter(milliseconds(1000));
+    limiter.enable_adaptive(AdaptiveRateOptions{});
+    for (int i = 0; i < 200; ++i) limiter.record_response("fast.com", 200, milliseconds(50));
+    EXPECT_EQ(limiter.get_host_delay("fast.com"), milliseconds(100));
+    for (int i = 0; i < 50; ++i) limiter.record_response("slow.com", 503, milliseconds(50));
+    EXPECT_EQ(limiter.get_host_delay("slow.com"), milliseconds(60000));
+}
+
+TEST(RateLimiter, CrawlDelayIsAFloor) {
+    RateLimiter limiter(milliseconds(1000));
+    limiter.enable_adaptive(AdaptiveRateOptions{});
+    limiter.set_host_delay("a.com", milliseconds(5000));
+    for (int i = 0; i < 100; ++i) limiter.record_response("a.com", 200, milliseconds(50));
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(5000));
+    for (int i = 0; i < 10; ++i) limiter.record_response("a.com", 503, milliseconds(50));
+    EXPECT_EQ(limiter.get_host_delay("a.com"), milliseconds(60000));  // backs off past the floor
+}
+
+TEST(RateLimiter, RetryAfterPushesOutEarliest) {
+    for (bool adaptive : {false, true}) {
+        RateLimiter limiter(milliseconds(0));
+        if (adaptive) limiter.enable_adaptive(AdaptiveRateOptions{});
+        auto before = std::chrono::steady_clock::now();
+        limiter.record_response("a.com", 429, milliseconds(10), seconds(30));
+        EXPECT_GE(limiter.earliest("a.com"), before + seconds(30)) << adaptive;
+        EXPECT_EQ(limiter.blocked_until("a.com"), limiter.earliest("a.com")) << adaptive;
+        // A shorter Retry-After does not shorten the block.
+        limiter.record_response("a.com", 429, milliseconds(10), seconds(5));
+        EXPECT_GE(limiter.earliest("a.com"), before + seconds(30)) << adaptive;
+        EXPECT_LT(limiter.earliest("b.com"), before);
+        limiter.reset_host("a.com");
+        EXPECT_LT(limiter.earliest("a.com"), before);
+    }
+}
+
+TEST(ParseRetryAfter, DeltaSeconds) {
+    EXPECT_EQ(parse_retry_after("", 0), seconds(0));
+    EXPECT_EQ(parse_retry_after("0", 0), seconds(0));
+    EXPECT_EQ(parse_retry_after("120", 0), seconds(120));
+    EXPECT_EQ(parse_retry_after("3600", 0), seconds(600));  // capped
+    EXPECT_EQ(parse_retry_after("-5", 0), seconds(0));
+    EXPECT_EQ(parse_retry_after("12s", 0), seconds(0));
+    EXPECT_EQ(parse_retry_after("soon", 0), seconds(0));
+}
+
+TEST(ParseRetryAfter, HttpDate) {
+    const int64_t now = 1445412480;  // Wed, 21 Oct 2015 07:28:00 GMT
+    EXPECT_EQ(parse_retry_after("Wed, 21 Oct 2015 07:30:00 GMT", now), seconds(120));
+    EXPECT_EQ(parse_retry_after("Wed, 21 Oct 2015 08:28:00 GMT", now), seconds(600));  // capped
+    EXPECT_EQ(parse_retry_after("Wed, 21 Oct 2015 07:00:00 GMT", now), seconds(0));    // in the past
+    EXPECT_EQ(parse_retry_after("21 Oct 2015 07:30:00", now), seconds(0));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/content_extractor.hpp"
+#include "scrape_llm/redirect_map.hpp"
+#include "test_helpers.hpp"
+
+using namespace scrapellm;
+
+namespace {
+
+std::string temp_file(const std::string& name) {
+    return scrapellm::testutil::fresh_temp_dir(name) + "/redirects.json";
+}
+
+} // namespace
+
+TEST(RedirectMap, ResolvesChainsAndStopsOnLoops) {
+    RedirectMap map(temp_file("redirect_chain"));
+    map.record("http://example.com/a", "https://example.com/a");
+    map.record("https://example.com/a", "https://example.com/b");
+    EXPECT_EQ(map.resolve("http://example.com/a"), "https://example.com/b");
+    EXPECT_EQ(map.resolve("https://example.com/c"), "https://example.com/c");
+
+    map.record("https://example.com/b", "http://example.com/a");
+    std::string end = map.resolve("http://example.com/a");
+    EXPECT_FALSE(end.empty());  // terminates on the loop
+}
+
+TEST(RedirectMap, PersistsAcrossRuns) {
+    std::string path = temp_file("redirect_persist");
+    {
+        RedirectMap map(path);
+        map.record("https://example.com/old", "https://example.com/new");
+        map.record("https://example.com/same", "https://example.com/same");
+        ASSERT_TRUE(map.save());
+    }
+    RedirectMap reloaded(path);
+    EXPECT_EQ(reloaded.size(), 1u);
+    EXPECT_EQ(reloaded.resolve("https://example.com/old"), "https://example.com/new");
+}
+
+TEST(CanonicalLink, FindsLinkInHead) {
+    std::string html = R"(<!DOCTYPE html><html><head><title>T</title>
+        <LINK REL="stylesheet" href="/style.css">
+        <link href='/products/42?b=2&amp;a=1' rel="canonical" />
+        </head><body><p>x</p></body></html>)";
+    EXPECT_EQ(canonical_link(html, "https://example.com/products/42?ref=home"),
+              "https://example.com/products/42?a=1&b=2");
+}
+
+TEST(CanonicalLink, IgnoresBodyAndMissingLinks) {
+    EXPECT_EQ(canonical_link("<html><head><title>T</title></head><body></body></html>", "https://example.com/"), "");
+    std::string in_body = R"(<html><head></head><body><link rel="canonical" href="/x"></body></html>)";
+    EXPECT_EQ(canonical_link(in_body, "https://example.com/"), "");
+    std::string not_http = R"html(<head><link rel=canonical href="javascript:void(0)"></head>)html";
+    EXPECT_EQ(canonical_link(not_http, "https://example.com/"), "");
+}
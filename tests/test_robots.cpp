@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "fetch/robots.hpp"
+
+using docscraper::fetch::RobotsHandler;
+using docscraper::fetch::RobotsMatcher;
+
+TEST(RobotsMatcher, PrefixMatch) {
+    RobotsMatcher m;
+    m.add("/private", false);
+    EXPECT_EQ(m.match("/private/x").disallow, 8);
+    EXPECT_EQ(m.match("/privat").disallow, -1);
+    EXPECT_EQ(m.match("/public").disallow, -1);
+}
+
+TEST(RobotsMatcher, WildcardAndAnchor) {
+    RobotsMatcher m;
+    m.add("/*.php$", false);
+    m.add("/fish*", true);
+    m.add("/*/secret/", false);
+    EXPECT_EQ(m.match("/index.php").disallow, 7);
+    EXPECT_EQ(m.match("/a/b/index.php").disallow, 7);
+    EXPECT_EQ(m.match("/index.php?x=1").disallow, -1);
+    EXPECT_EQ(m.match("/fish").allow, 6);
+    EXPECT_EQ(m.match("/fishheads/x").allow, 6);
+    EXPECT_EQ(m.match("/a/b/secret/c").disallow, 10);
+    EXPECT_EQ(m.match("/secret/").disallow, -1);
+}
+
+TEST(RobotsMatcher, EmptyPatternMatchesNothing) {
+    RobotsMatcher m;
+    m.add("", false);
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.match("/anything").disallow, -1);
+}
+
+TEST(RobotsHandler, LongestMatchWins) {
+    RobotsHandler h;
+    h.parse(
+        "User-agent: *\n"
+        "Disallow: /docs/\n"
+        "Allow: /docs/public/\n"
+        "Disallow: /*.pdf$\n"
+        "Allow: /$\n");
+    EXPECT_FALSE(h.is_allowed("/docs/internal"));
+    EXPECT_TRUE(h.is_allowed("/docs/public/page"));
+    EXPECT_TRUE(h.is_allowed("/docs/public/file.pdf"));  // 13-char allow beats 7-char disallow
+    EXPECT_FALSE(h.is_allowed("/file.pdf"));
+    EXPECT_TRUE(h.is_allowed("/file.pdf?download=1"));
+    EXPECT_TRUE(h.is_allowed("/"));
+    EXPECT_TRUE(h.is_allowed("/other"));
+}
+
+TEST(RobotsHandler, DisallowAllAndTieGoesToAllow) {
+    RobotsHandler h;
+    h.parse("User-agent: *\nDisallow: /\nAllow: /a\nDisallow: /a\n");
+    EXPECT_FALSE(h.is_allowed("/b"));
+    EXPECT_TRUE(h.is_allowed("/a/b"));
+}
+
+TEST(RobotsHandler, AgentGroupAndCrawlDelay) {
+    RobotsHandler h;
+    h.parse("User-agent: scrape-llm\nDisallow: /x\nCrawl-delay: 3\n\nUser-agent: *\nDisallow: /y\n");
+    EXPECT_FALSE(h.is_allowed("/x", "scrape-llm"));
+    EXPECT_TRUE(h.is_allowed("/y", "scrape-llm"));
+    EXPECT_FALSE(h.is_allowed("/y"));
+    EXPECT_EQ(h.crawl_delay_seconds("scrape-llm"), 3);
+    EXPECT_EQ(h.crawl_delay_seconds(), -1);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/robots_cache.hpp"
+#include "test_helpers.hpp"
+#include <fstream>
+#include <string>
+
+using scrapellm::RobotsCache;
+using scrapellm::testutil::fresh_temp_dir;
+
+namespace {
+
+const char* kOrigin = "https://example.com";
+const char* kRobots = "User-agent: *\nDisallow: /private\nCrawl-delay: 3\n";
+
+RobotsCache::Options memory_only() {
+    return RobotsCache::Options{"", 1000, 60};
+}
+
+} // namespace
+
+TEST(RobotsCache, FetchedRulesExpireAfterTtl) {
+    RobotsCache cache(memory_only());
+    EXPECT_EQ(cache.get(kOrigin, 100), nullptr);
+    auto e = cache.put(kOrigin, 200, kRobots, 100);
+    EXPECT_FALSE(e->rules->is_allowed("/private/x"));
+    EXPECT_TRUE(e->rules->is_allowed("/public"));
+    EXPECT_EQ(e->rules->crawl_delay_seconds(), 3);
+
+    EXPECT_EQ(cache.get(kOrigin, 1099), e);
+    EXPECT_EQ(cache.get(kOrigin, 1100), nullptr);
+    EXPECT_EQ(cache.get("https://example.com:8443", 100), nullptr);  // origins include the port
+}
+
+TEST(RobotsCache, ClientErrorAllowsEverythingForTtl) {
+    RobotsCache cache(memory_only());
+    auto e = cache.put(kOrigin, 404, "<html>not found</html>", 100);
+    EXPECT_TRUE(e->rules->is_allowed("/private/x"));
+    EXPECT_TRUE(e->body.empty());
+    EXPECT_NE(cache.get(kOrigin, 1099), nullptr);
+    EXPECT_EQ(cache.get(kOrigin, 1100), nullptr);
+}
+
+TEST(RobotsCache, ServerAndNetworkErrorsDisallowEverythingBriefly) {
+    RobotsCache cache(memory_only());
+    for (int status : {503, 0}) {
+        auto e = cache.put(kOrigin, status, "", 100);
+        EXPECT_FALSE(e->rules->is_allowed("/"));
+        EXPECT_FALSE(e->rules->is_allowed("/public"));
+        EXPECT_NE(cache.get(kOrigin, 159), nullptr);
+        EXPECT_EQ(cache.get(kOrigin, 160), nullptr);
+    }
+}
+
+TEST(RobotsCache, PersistsToRobotsJson) {
+    std::string dir = fresh_temp_dir("robots_cache");
+    RobotsCache::Options options{dir + "/cache/robots.json", 1000, 60};
+    {
+        RobotsCache cache(options);
+        cache.put(kOrigin, 200, kRobots, 100);
+        cache.put("https://down.example.com", 500, "", 100);
+        ASSERT_TRUE(cache.save());
+    }
+    RobotsCache cache(options);
+    auto e = cache.get(kOrigin, 200);
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->status, 200);
+    EXPECT_EQ(e->fetched_at, 100);
+    EXPECT_EQ(e->body, kRobots);
+    EXPECT_FALSE(e->rules->is_allowed("/private/x"));
+    EXPECT_EQ(e->rules->crawl_delay_seconds(), 3);
+
+    auto down = cache.get("https://down.example.com", 120);
+    ASSERT_NE(down, nullptr);
+    EXPECT_FALSE(down->rules->is_allowed("/"));
+    EXPECT_EQ(cache.get("https://down.example.com", 160), nullptr);
+}
+
+TEST(RobotsCache, CorruptFileStartsEmpty) {
+    std::string dir = fresh_temp_dir("robots_cache_corrupt");
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir + "/robots.json") << "{\"https://example.com\": {\"status\": 2";
+    RobotsCache cache(RobotsCache::Options{dir + "/robots.json", 1000, 60});
+    EXPECT_EQ(cache.get(kOrigin, 100), nullptr);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "utils/simhash.hpp"
+#include <string>
+
+using namespace docscraper::utils;
+
+namespace {
+
+std::string article(const std::string& extra = "") {
+    return "Widget Pro 3000 is our most popular widget. It ships with a steel frame, a two year warranty "
+           "and free returns. The price is 49 dollars and it is available in red, blue and green. "
+           "Customers rate it four point seven out of five stars across more than two thousand reviews. " +
+           extra;
+}
+
+} // namespace
+
+TEST(SimHash, ShortTextHasNoFingerprint) {
+    EXPECT_EQ(simhash64(""), 0u);
+    EXPECT_EQ(simhash64("Home | About | Contact"), 0u);
+    EXPECT_NE(simhash64(article()), 0u);
+}
+
+TEST(SimHash, NearDuplicatesAreClose) {
+    uint64_t a = simhash64(article());
+    EXPECT_EQ(a, simhash64(article()));
+    // Case and punctuation do not matter.
+    std::string shouted = article();
+    for (auto& c : shouted) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    EXPECT_EQ(a, simhash64(shouted));
+    // A small change (a session banner) moves only a few bits.
+    EXPECT_LE(hamming_distance(a, simhash64(article("Session 8f3a."))), 6);
+    // Unrelated text lands far away.
+    uint64_t other = simhash64(
+        "Release notes for version 2.4: the installer now detects existing configuration files, the "
+        "command line accepts a new verbose flag, and several crashes on startup were fixed for users "
+        "running older operating systems with unusual locale settings.");
+    EXPECT_GT(hamming_distance(a, other), 12);
+}
+
+TEST(SimHashIndex, FindsFirstWithinDistance) {
+    SimHashIndex index(3);
+    uint64_t base = 0xF0F0F0F0F0F0F0F0ULL;
+    index.insert(base, 10);
+    index.insert(base ^ 0x1, 11);
+    EXPECT_EQ(index.find(base), 10u);
+    EXPECT_EQ(index.find(base ^ 0x1), 10u);  // both match; the earlier one wins
+    EXPECT_EQ(index.find(base ^ 0x8000000000000007ULL), 11u);  // 4 bits from base, 3 from the second
+    EXPECT_FALSE(index.find(base ^ 0xF000000000000000ULL).has_value());
+    EXPECT_FALSE(index.find(~base).has_value());
+}
+
+TEST(SimHashIndex, DistanceZeroIsExactMatch) {
+    SimHashIndex index(0);
+    index.insert(42, 0);
+    EXPECT_EQ(index.find(42), 0u);
+    EXPECT_FALSE(index.find(43).has_value());
+}
+
+TEST(SimHashIndex, AgreesWithBruteForce) {
+    SimHashIndex index(5);
+    std::vector<uint64_t> stored;
+    uint64_t x = 0x123456789ABCDEFULL;
+    auto next = [&x] {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    };
+    for (size_t i = 0; i < 2000; ++i) {
+        uint64_t fp = next();
+        stored.push_back(fp);
+        index.insert(fp, i);
+    }
+    for (int q = 0; q < 2000; ++q) {
+        // Queries near stored entries and random ones.
+        uint64_t fp = q % 2 ? stored[static_cast<size_t>(q)] ^ (next() & next() & next()) : next();
+        std::optional<size_t> expected;
+        for (size_t i = 0; i < stored.size(); ++i)
+            if (hamming_distance(fp, stored[i]) <= 5) {
+                expected = i;
+                break;
+            }
+        ASSERT_EQ(index.find(fp), expected);
+    }
+}
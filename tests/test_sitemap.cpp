@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "parse/sitemap.hpp"
+#include <string>
+#include <vector>
+
+using docscraper::parse::SitemapEntry;
+using docscraper::parse::SitemapParser;
+using docscraper::parse::parse_w3c_datetime;
+
+namespace {
+
+const char* kUrlset = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!-- generated -->
+<urlset xmlns="http://www.sitemaps.org/schemas/sitemap/0.9">
+  <url>
+    <loc>https://example.com/a</loc>
+    <lastmod>2024-05-01</lastmod>
+    <changefreq>daily</changefreq>
+  </url>
+  <url><loc> https://example.com/b?x=1&amp;y=2 </loc></url>
+  <url><loc><![CDATA[https://example.com/c?p=1&q=<2>]]></loc></url>
+  <url><loc>https://example.com/caf&#xE9;&#47;d</loc></url>
+  <url><lastmod>2024-01-01</lastmod></url>
+</urlset>
+)";
+
+std::vector<SitemapEntry> parse_in_chunks(const std::string& xml, size_t chunk) {
+    std::vector<SitemapEntry> out;
+    SitemapParser parser([&out](const SitemapEntry& e) {
+        out.push_back(e);
+        return true;
+    });
+    for (size_t pos = 0; pos < xml.size(); pos += chunk)
+        EXPECT_TRUE(parser.feed(xml.data() + pos, std::min(chunk, xml.size() - pos)));
+    EXPECT_EQ(parser.entries(), out.size());
+    return out;
+}
+
+} // namespace
+
+TEST(SitemapParser, ReadsUrlsetEntitiesAndCdata) {
+    auto entries = parse_in_chunks(kUrlset, std::string(kUrlset).size());
+    ASSERT_EQ(entries.size(), 4u);  // the <url> without <loc> is dropped
+    EXPECT_EQ(entries[0].loc, "https://example.com/a");
+    EXPECT_EQ(entries[0].lastmod, "2024-05-01");
+    EXPECT_FALSE(entries[0].is_sitemap);
+    EXPECT_EQ(entries[1].loc, "https://example.com/b?x=1&y=2");
+    EXPECT_EQ(entries[1].lastmod, "");
+    EXPECT_EQ(entries[2].loc, "https://example.com/c?p=1&q=<2>");
+    EXPECT_EQ(entries[3].loc, "https://example.com/caf\xC3\xA9/d");
+}
+
+TEST(SitemapParser, ReadsSitemapIndexWithPrefixes) {
+    std::string xml = R"(<sm:sitemapindex xmlns:sm="http://www.sitemaps.org/schemas/sitemap/0.9">
+  <sm:sitemap><sm:loc>https://example.com/sitemap-1.xml.gz</sm:loc><sm:lastmod>2024-05-01T10:00:00Z</sm:lastmod></sm:sitemap>
+  <sm:sitemap><sm:loc>https://example.com/sitemap-2.xml</sm:loc></sm:sitemap>
+</sm:sitemapindex>)";
+    auto entries = parse_in_chunks(xml, xml.size());
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_TRUE(entries[0].is_sitemap);
+    EXPECT_EQ(entries[0].loc, "https://example.com/sitemap-1.xml.gz");
+    EXPECT_EQ(entries[0].lastmod, "2024-05-01T10:00:00Z");
+    EXPECT_EQ(entries[1].loc, "https://example.com/sitemap-2.xml");
+}
+
+TEST(SitemapParser, SameResultAtAnyChunkBoundary) {
+    auto whole = parse_in_chunks(kUrlset, std::string(kUrlset).size());
+    for (size_t chunk : {1, 2, 3, 5, 8, 13, 64}) {
+        auto split = parse_in_chunks(kUrlset, chunk);
+        ASSERT_EQ(split.size(), whole.size()) << chunk;
+        for (size_t i = 0; i < whole.size(); ++i) {
+            EXPECT_EQ(split[i].loc, whole[i].loc) << chunk;
+            EXPECT_EQ(split[i].lastmod, whole[i].lastmod) << chunk;
+        }
+    }
+}
+
+TEST(SitemapParser, CallbackStopsParsing) {
+    std::vector<std::string> seen;
+    SitemapParser parser([&seen](const SitemapEntry& e) {
+        seen.push_back(e.loc);
+        return seen.size() < 2;
+    });
+    std::string xml = kUrlset;
+    EXPECT_FALSE(parser.feed(xml.data(), xml.size()));
+    EXPECT_FALSE(parser.feed("<url><loc>https://example.com/z</loc></url>", 41));
+    EXPECT_EQ(seen.size(), 2u);
+}
+
+TEST(SitemapParser, DropsOversizedLoc) {
+    std::string xml = "<urlset><url><loc>https://example.com/" + std::string(20000, 'a') +
+                      "</loc></url><url><loc>https://example.com/ok</loc></url></urlset>";
+    auto entries = parse_in_chunks(xml, 1000);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].loc, "https://example.com/ok");
+}
+
+TEST(W3cDatetime, ParsesEveryPrecision) {
+    EXPECT_EQ(parse_w3c_datetime("1997"), 852076800);
+    EXPECT_EQ(parse_w3c_datetime("1997-07"), 867715200);
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16"), 869011200);
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16T19:20Z"), 869080800);
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16T19:20:30Z"), 869080830);
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16T19:20:30.45Z"), 869080830);
+    EXPECT_EQ(parse_w3c_datetime(" 1997-07-16T19:20:30 "), 869080830);  // no TZD: read as UTC
+}
+
+TEST(W3cDatetime, AppliesTimezoneOffsets) {
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16T19:20:30+01:00"), 869077230);
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16T19:20:30-01:30"), 869086230);
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16T19:20+01:00"), 869077200);
+    EXPECT_EQ(parse_w3c_datetime("1997-07-16T19:20:30.45+00:00"), 869080830);
+}
+
+TEST(W3cDatetime, InvalidInputIsZero) {
+    for (const char* bad : {"", "97", "1997-7", "1997-07-1", "1997-13-01", "1997-00-10", "1997-07-32",
+                            "1997-07-16T24:00Z", "1997-07-16T19Z", "1997-07-16T19:61Z", "1997-07-16T19:20+0100",
+                            "1997-07-16T19:20:30X", "1997-07-16 19:20:30", "yesterday"})
+        EXPECT_EQ(parse_w3c_datetime(bad), 0) << bad;
+}
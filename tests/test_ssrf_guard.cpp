@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/ssrf_guard.hpp"
+
+using scrapellm::is_private_address;
+using scrapellm::url_allowed_ssrf;
+
+TEST(SsrfGuard, PrivateIPv4) {
+    EXPECT_TRUE(is_private_address("127.0.0.1"));
+    EXPECT_TRUE(is_private_address("10.1.2.3"));
+    EXPECT_TRUE(is_private_address("172.16.0.1"));
+    EXPECT_TRUE(is_private_address("172.31.255.255"));
+    EXPECT_TRUE(is_private_address("192.168.0.10"));
+    EXPECT_TRUE(is_private_address("169.254.169.254"));
+    EXPECT_TRUE(is_private_address("100.64.0.1"));
+    EXPECT_TRUE(is_private_address("0.0.0.0"));
+    EXPECT_TRUE(is_private_address("224.0.0.1"));
+    EXPECT_FALSE(is_private_address("172.32.0.1"));
+    EXPECT_FALSE(is_private_address("8.8.8.8"));
+    EXPECT_FALSE(is_private_address("93.184.216.34"));
+}
+
+TEST(SsrfGuard, PrivateIPv6) {
+    EXPECT_TRUE(is_private_address("::1"));
+    EXPECT_TRUE(is_private_address("[::1]"));
+    EXPECT_TRUE(is_private_address("::"));
+    EXPECT_TRUE(is_private_address("fd00::1"));
+    EXPECT_TRUE(is_private_address("fe80::1"));
+    EXPECT_TRUE(is_private_address("ff02::1"));
+    EXPECT_TRUE(is_private_address("::ffff:127.0.0.1"));
+    EXPECT_TRUE(is_private_address("::ffff:10.0.0.1"));
+    EXPECT_TRUE(is_private_address("64:ff9b::192.168.1.1"));
+    EXPECT_FALSE(is_private_address("::ffff:8.8.8.8"));
+    EXPECT_FALSE(is_private_address("2001:4860:4860::8888"));
+}
+
+TEST(SsrfGuard, NamesAreNotAddresses) {
+    EXPECT_FALSE(is_private_address("example.com"));
+    EXPECT_FALSE(is_private_address("127.example.com"));
+}
+
+TEST(SsrfGuard, LiteralHostInUrl) {
+    EXPECT_FALSE(url_allowed_ssrf("http://localhost/", false));
+    EXPECT_FALSE(url_allowed_ssrf("http://127.0.0.1:8080/x", false));
+    EXPECT_FALSE(url_allowed_ssrf("http://169.254.169.254/latest/meta-data", false));
+    EXPECT_FALSE(url_allowed_ssrf("ftp://example.com/", false));
+    EXPECT_TRUE(url_allowed_ssrf("https://example.com/docs", false));
+    EXPECT_TRUE(url_allowed_ssrf("http://127.0.0.1/", true));
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/stream_decoder.hpp"
+#include <zlib.h>
+#include <string>
+
+using scrapellm::StreamDecoder;
+
+namespace {
+
+// window_bits: 31 = gzip, 15 = zlib-wrapped deflate, -15 = raw deflate.
+std::string deflate_with(const std::string& in, int window_bits) {
+    z_stream zs{};
+    deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&zs, static_cast<uLong>(in.size())), '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+    zs.avail_in = static_cast<uInt>(in.size());
+    zs.next_out = reinterpret_cast<Bytef*>(out.data());
+    zs.avail_out = static_cast<uInt>(out.size());
+    deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+std::string page() {
+    std::string html = "<html><body>";
+    for (int i = 0; i < 500; ++i) html += "<p>Item " + std::to_string(i) + " costs $" + std::to_string(i * 3) + "</p>";
+    return html + "</body></html>";
+}
+
+// Feed in chunks of chunk_size and collect the output.
+bool decode(StreamDecoder& d, const std::string& in, size_t chunk_size, std::string& out) {
+    auto sink = [&out](const char* data, size_t len) {
+        out.append(data, len);
+        return true;
+    };
+    for (size_t pos = 0; pos < in.size(); pos += chunk_size)
+        if (!d.write(in.data() + pos, std::min(chunk_size, in.size() - pos), sink)) return false;
+    return true;
+}
+
+} // namespace
+
+TEST(StreamDecoder, CreatesDecodersForSupportedCodings) {
+    EXPECT_NE(StreamDecoder::create("gzip"), nullptr);
+    EXPECT_NE(StreamDecoder::create(" X-Gzip "), nullptr);
+    EXPECT_NE(StreamDecoder::create("deflate"), nullptr);
+    EXPECT_EQ(StreamDecoder::create(""), nullptr);
+    EXPECT_EQ(StreamDecoder::create("identity"), nullptr);
+    EXPECT_TRUE(StreamDecoder::supports_encoding("identity"));
+    EXPECT_FALSE(StreamDecoder::supports_encoding("zstd"));
+}
+
+TEST(StreamDecoder, DecodesGzipInAnyChunking) {
+    std::string html = page();
+    std::string gz = deflate_with(html, 31);
+    for (size_t chunk : {size_t{1}, size_t{7}, size_t{4096}, gz.size()}) {
+        auto d = StreamDecoder::create("gzip");
+        std::string out;
+        ASSERT_TRUE(decode(*d, gz, chunk, out)) << chunk;
+        EXPECT_EQ(out, html) << chunk;
+        EXPECT_TRUE(d->finished()) << chunk;
+    }
+}
+
+TEST(StreamDecoder, DeflateAcceptsZlibAndRawStreams) {
+    std::string html = page();
+    for (int bits : {15, -15}) {
+        auto d = StreamDecoder::create("deflate");
+        std::string out;
+        ASSERT_TRUE(decode(*d, deflate_with(html, bits), 3, out)) << bits;
+        EXPECT_EQ(out, html) << bits;
+        EXPECT_TRUE(d->finished()) << bits;
+    }
+}
+
+TEST(StreamDecoder, TruncatedStreamIsNotFinished) {
+    std::string gz = deflate_with(page(), 31);
+    auto d = StreamDecoder::create("gzip");
+    std::string out;
+    ASSERT_TRUE(decode(*d, gz.substr(0, gz.size() / 2), 64, out));
+    EXPECT_FALSE(d->finished());
+
+    // Missing only the gzip trailer (CRC and length) still counts as truncated.
+    auto tail = StreamDecoder::create("gzip");
+    out.clear();
+    ASSERT_TRUE(decode(*tail, gz.substr(0, gz.size() - 4), 64, out));
+    EXPECT_FALSE(tail->finished());
+}
+
+TEST(StreamDecoder, CorruptInputFails) {
+    std::string gz = deflate_with(page(), 31);
+    gz[gz.size() / 2] ^= 0x55;
+    gz[gz.size() / 2 + 1] ^= 0x55;
+    auto d = StreamDecoder::create("gzip");
+    std::string out;
+    EXPECT_FALSE(decode(*d, gz, 4096, out));
+    EXPECT_FALSE(d->finished());
+}
+
+TEST(StreamDecoder, SinkRefusalStopsDecompressionBomb) {
+    // 64 MB of zeros compresses to about 64 KB; the sink caps decoded output at 1 MB.
+    std::string bomb = deflate_with(std::string(64u << 20, '\0'), 31);
+    auto d = StreamDecoder::create("gzip");
+    const size_t cap = 1u << 20;
+    size_t decoded = 0;
+    auto sink = [&](const char*, size_t len) {
+        if (decoded + len > cap) return false;
+        decoded += len;
+        return true;
+    };
+    bool ok = true;
+    for (size_t pos = 0; ok && pos < bomb.size(); pos += 4096)
+        ok = d->write(bomb.data() + pos, std::min<size_t>(4096, bomb.size() - pos), sink);
+    EXPECT_FALSE(ok);
+    EXPECT_LE(decoded, cap);
+    EXPECT_FALSE(d->finished());
+}
+
+TEST(StreamDecoder, DecodesBrotli) {
+    if (!StreamDecoder::supports_encoding("br")) GTEST_SKIP() << "built without brotli";
+    const unsigned char br[] = {
+        0x1b, 0x3b, 0x00, 0xf8, 0x8d, 0xd4, 0x61, 0xcd, 0x9d, 0x07, 0x72, 0x1b,
+        0x5b, 0xb7, 0x35, 0xc4, 0x37, 0x5a, 0x05, 0x46, 0x12, 0xc5, 0x4b, 0xd2,
+        0x22, 0xce, 0x50, 0x99, 0x00, 0x28, 0xc0, 0x80, 0xfa, 0x11, 0xe7, 0x11,
+        0x66, 0xde, 0xbe, 0x3a, 0x04, 0xcc, 0x02};
+    std::string in(reinterpret_cast<const char*>(br), sizeof(br));
+
+    auto d = StreamDecoder::create("br");
+    std::string out;
+    ASSERT_TRUE(decode(*d, in, 5, out));
+    EXPECT_EQ(out, "<html><body><p>brotli brotli brotli brotli</p></body></html>");
+    EXPECT_TRUE(d->finished());
+
+    auto cut = StreamDecoder::create("br");
+    out.clear();
+    ASSERT_TRUE(decode(*cut, in.substr(0, in.size() - 3), 5, out));
+    EXPECT_FALSE(cut->finished());
+}
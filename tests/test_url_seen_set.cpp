@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "utils/url_seen_set.hpp"
+#include <string>
+
+using docscraper::utils::UrlSeenSet;
+
+TEST(UrlSeenSet, InsertReportsNewOnce) {
+    UrlSeenSet s;
+    EXPECT_TRUE(s.insert("https://example.com/a"));
+    EXPECT_FALSE(s.insert("https://example.com/a"));
+    EXPECT_TRUE(s.insert("https://example.com/b"));
+    EXPECT_TRUE(s.contains("https://example.com/a"));
+    EXPECT_FALSE(s.contains("https://example.com/c"));
+    EXPECT_EQ(s.size(), 2u);
+}
+
+TEST(UrlSeenSet, GrowsPastExpectedSize) {
+    UrlSeenSet s(UrlSeenSet::Options{16, 0.0});
+    for (int i = 0; i < 100000; ++i) ASSERT_TRUE(s.insert("https://example.com/p/" + std::to_string(i)));
+    for (int i = 0; i < 100000; ++i) ASSERT_TRUE(s.contains("https://example.com/p/" + std::to_string(i)));
+    EXPECT_FALSE(s.contains("https://example.com/p/100000"));
+    EXPECT_EQ(s.size(), 100000u);
+    EXPECT_LT(s.memory_bytes(), 100000u * 24);
+}
+
+TEST(UrlSeenSet, BloomFrontGivesSameAnswers) {
+    UrlSeenSet plain;
+    UrlSeenSet bloom(UrlSeenSet::Options{1000, 0.01});  // overfilled on purpose
+    for (int i = 0; i < 20000; ++i) {
+        std::string url = "https://example.com/" + std::to_string(i % 7000);
+        ASSERT_EQ(plain.insert(url), bloom.insert(url)) << url;
+    }
+    for (int i = 0; i < 10000; ++i) {
+        std::string url = "https://example.com/" + std::to_string(i);
+        ASSERT_EQ(plain.contains(url), bloom.contains(url)) << url;
+    }
+    EXPECT_EQ(bloom.size(), 7000u);
+}
+
+TEST(UrlSeenSet, FingerprintsRoundTrip) {
+    UrlSeenSet a;
+    for (int i = 0; i < 500; ++i) a.insert("u" + std::to_string(i));
+    UrlSeenSet b;
+    for (uint64_t fp : a.fingerprints()) EXPECT_TRUE(b.insert_fingerprint(fp));
+    EXPECT_EQ(b.size(), 500u);
+    EXPECT_TRUE(b.contains("u123"));
+    a.clear();
+    EXPECT_TRUE(a.empty());
+    EXPECT_FALSE(a.contains("u123"));
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "scrape_llm/url_template.hpp"
+
+using namespace scrapellm;
+
+TEST(UrlTemplate, MasksVaryingPathSegments) {
+    EXPECT_EQ(url_template("https://shop.example.com/product/12345"), "/product/{num}");
+    EXPECT_EQ(url_template("https://shop.example.com/product/67890"), "/product/{num}");
+    EXPECT_EQ(url_template("https://shop.example.com/p/blue-steel-widget-pro"), "/p/{slug}");
+    EXPECT_EQ(url_template("https://shop.example.com/item/SKU4471B.html"), "/item/{id}.html");
+    EXPECT_EQ(url_template("https://example.com/files/9f86d081884c7d659a2feaa0c55ad015"), "/files/{hash}");
+    EXPECT_EQ(url_template("https://example.com/o/123e4567-e89b-12d3-a456-426614174000/"), "/o/{hash}/");
+}
+
+TEST(UrlTemplate, KeepsStructuralSegments) {
+    EXPECT_EQ(url_template("https://example.com/"), "/");
+    EXPECT_EQ(url_template("https://example.com/docs/release-notes"), "/docs/release-notes");
+    EXPECT_EQ(url_template("https://example.com/Category/Shoes/"), "/category/shoes/");
+    EXPECT_NE(url_template("https://example.com/blog/2024"), url_template("https://example.com/product/2024"));
+}
+
+TEST(UrlTemplate, MasksQueryValuesAndSortsKeys) {
+    EXPECT_EQ(url_template("https://example.com/list?sort=price&page=3"), "/list?page={num}&sort={val}");
+    EXPECT_EQ(url_template("https://example.com/list?page=4&sort=name"), "/list?page={num}&sort={val}");
+    EXPECT_EQ(url_template("https://example.com/list?print"), "/list?print={val}");
+}
+
+TEST(TemplatePolicy, CapsFetchesPerTemplate) {
+    TemplatePolicy policy(TemplatePolicy::Options{3, 0, 10});
+    TemplateStats stats;
+    int admitted = 0;
+    for (int i = 0; i < 10; ++i) {
+        if (policy.admit(stats)) {
+            ++stats.fetched;
+            ++admitted;
+        } else {
+            ++stats.skipped;
+        }
+    }
+    EXPECT_EQ(admitted, 3);
+    EXPECT_EQ(stats.skipped, 7);
+}
+
+TEST(TemplatePolicy, SamplesOffTopicTemplates) {
+    TemplatePolicy policy(TemplatePolicy::Options{0, 5, 10});
+    TemplateStats stats;
+    for (int i = 0; i < 105; ++i) {
+        if (policy.admit(stats)) ++stats.fetched;
+        else ++stats.skipped;
+    }
+    // 5 probes, then 1 in 10 of the remaining 100.
+    EXPECT_EQ(stats.fetched, 15);
+
+    // One on-topic page lifts the sampling.
+    stats.on_topic = 1;
+    EXPECT_TRUE(policy.admit(stats));
+}